@@ -0,0 +1,705 @@
+// bench_main.cpp
+//
+// Microbenchmarks for the rasterisation, simulation and collision kernels.
+// Links against the counting null GL backend (null_gl.cpp), so it runs
+// headless and the draw benchmarks measure CPU cost + GL calls submitted.
+//
+// Usage: tank_bench [--filter <substring>] [--reps <n>] [--min-time-ms <n>]
+//        tank_bench --stress [stress options, see stress.h]
+// Prints one JSON document on stdout.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../fixed.h"
+#include "../game.h"
+#include "../graphics.h"
+#include "../obstacles.h"
+#include "../fog.h"
+#include "../events.h"
+#include "../telemetry.h"
+#include "../terrain.h"
+#include "../scheduler.h"
+#include "../swept.h"
+#include "../transform.h"
+#include "../render.h"
+#include "../stress.h"
+#include "null_gl.h"
+
+// =====================================================
+// Harness
+// =====================================================
+
+// A benchmark runs 'ops' operations and returns the nanoseconds spent in the
+// measured region (so it can exclude its own setup).
+using BenchFn = double (*)(long long ops);
+
+struct BenchCase {
+    char    name[64];
+    BenchFn fn;
+};
+
+static int    benchReps      = 15;
+static double benchMinTimeNs = 5e6;   // each repetition runs at least 5 ms
+static int    benchPrinted   = 0;
+
+using BenchClock = std::chrono::steady_clock;
+
+static double elapsedNs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+static void runCase(const BenchCase& bc) {
+    // Calibrate: double the op count until one run takes long enough
+    long long ops = 1;
+    while (bc.fn(ops) < benchMinTimeNs && ops < (1LL << 40)) ops *= 2;
+
+    std::vector<double> nsPerOp;
+    long long calls = 0, verts = 0;
+    for (int r = 0; r < benchReps; ++r) {
+        resetNullGl();
+        nsPerOp.push_back(bc.fn(ops) / ops);
+        calls = nullGl.calls;
+        verts = nullGl.vertices;
+    }
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    double median = nsPerOp[nsPerOp.size() / 2];
+
+    // Median absolute deviation: robust spread, insensitive to one noisy rep
+    std::vector<double> dev;
+    for (double v : nsPerOp) dev.push_back(v > median ? v - median : median - v);
+    std::sort(dev.begin(), dev.end());
+    double mad = dev[dev.size() / 2];
+
+    std::printf("%s    {\"name\": \"%s\", \"ops_per_rep\": %lld, \"reps\": %d, "
+                "\"ns_per_op\": {\"median\": %.3f, \"min\": %.3f, \"max\": %.3f, \"mad\": %.3f}, "
+                "\"gl_calls_per_op\": %.3f, \"vertices_per_op\": %.3f}",
+                benchPrinted++ ? ",\n" : "", bc.name, ops, benchReps,
+                median, nsPerOp.front(), nsPerOp.back(), mad,
+                (double)calls / ops, (double)verts / ops);
+}
+
+// =====================================================
+// Rasterisation
+// =====================================================
+
+static int rasterLen = 0;   // line length / circle radius for the current case
+
+// The rasterisers record into the render arena; rewind it every few shapes so
+// a long run never overflows it (the rewind is cheap and counted in the time)
+constexpr int SHAPES_PER_FRAME = 64;
+
+static double benchLineDDA(long long ops) {
+    renderBeginFrame();
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        if (i % SHAPES_PER_FRAME == 0) renderBeginFrame();
+        drawLineDDA(0, 0, rasterLen, rasterLen * 3 / 4);
+    }
+    return elapsedNs(start);
+}
+
+static double benchLineBresenham(long long ops) {
+    renderBeginFrame();
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        if (i % SHAPES_PER_FRAME == 0) renderBeginFrame();
+        drawLineBresenham(0, 0, rasterLen, rasterLen * 3 / 4);
+    }
+    return elapsedNs(start);
+}
+
+static double benchCircleMidpoint(long long ops) {
+    renderBeginFrame();
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        if (i % SHAPES_PER_FRAME == 0) renderBeginFrame();
+        drawCircleMidpoint(400, 300, rasterLen);
+    }
+    return elapsedNs(start);
+}
+
+// Whole frame: record every layer and submit it to the null backend
+static double benchDrawScene(long long ops) {
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) drawScene();
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Math: fixed-point table trig vs libm
+// =====================================================
+
+static volatile int32_t mathSink;
+
+// One heading step per op, the way a tank's forward vector is built
+static double benchFxSinCos(long long ops) {
+    int32_t acc = 0;
+    BAngle  a   = 0;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        a += 4099;
+        acc += fxSin(a).raw ^ fxCos(a).raw;
+    }
+    double ns = elapsedNs(start);
+    mathSink = acc;
+    return ns;
+}
+
+static double benchStdSinCos(long long ops) {
+    float acc = 0.0f, degrees = 0.0f;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        degrees += 22.5149f;
+        if (degrees >= 360.0f) degrees -= 360.0f;
+        float r = degrees * 3.14159265f / 180.0f;
+        acc += std::sin(r) - std::cos(r);
+    }
+    double ns = elapsedNs(start);
+    mathSink = (int32_t)acc;
+    return ns;
+}
+
+// =====================================================
+// Simulation
+// =====================================================
+
+constexpr unsigned BENCH_SEED     = 12345u;
+constexpr int      TICKS_PER_WAVE = 32;   // ticks simulated before the world is re-seeded
+
+// initGraphics() issues GL calls (projection, clear color); keep them out of the counters
+static void initGameUncounted() {
+    NullGlCounters saved = nullGl;
+    initGraphics();
+    initGame();
+    nullGl = saved;
+}
+
+// Deterministic world: every bullet slot in flight in a random direction
+static void seedWorld() {
+    initGameUncounted();
+    std::srand(BENCH_SEED);   // bullets below
+    seedSpawns(BENCH_SEED);   // initGame seeds from the clock
+    resetTargets();
+
+    for (Bullet& b : bullets) {
+        float fx = std::rand() / (float)RAND_MAX;
+        float fy = std::rand() / (float)RAND_MAX;
+        float fa = std::rand() / (float)RAND_MAX;
+        b.x = FieldCoord::fromFixed(Fixed::fromFloat(140.0f + fx * 520.0f));
+        b.y = FieldCoord::fromFixed(Fixed::fromFloat(140.0f + fy * 320.0f));
+        b.heading = (BAngle)(int)(fa * BANGLE_TURN);
+    }
+    for (int i = 0; i < (int)bullets.size(); ++i) bulletActive.set(i);
+}
+
+static double benchUpdateGame(long long ops) {
+    double ns = 0.0;
+    long long done = 0;
+    while (done < ops) {
+        seedWorld();
+        long long ticks = std::min<long long>(TICKS_PER_WAVE, ops - done);
+
+        auto start = BenchClock::now();
+        for (long long t = 0; t < ticks; ++t) updateGame();
+        ns += elapsedNs(start);
+        done += ticks;
+    }
+    return ns;
+}
+
+// Worst case for the linear slot search: only the last slot is free
+static double benchSpawnBullet(long long ops) {
+    initGameUncounted();
+    for (int i = 0; i < (int)bullets.size(); ++i) bulletActive.set(i);
+    int last = (int)bullets.size() - 1;
+
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        bulletActive.reset(last);
+        spawnBullet();
+    }
+    return elapsedNs(start);
+}
+
+static double benchResetTargets(long long ops) {
+    initGameUncounted();
+    seedSpawns(BENCH_SEED);
+
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) resetTargets();
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Collision (obstacle BVH)
+// =====================================================
+
+constexpr int QUERY_COUNT = 1024;   // distinct rays / sweeps cycled through
+
+struct BenchQuery {
+    float x0, y0, x1, y1;
+    Fixed fx0, fy0, fx1, fy1;   // same segment in sim units
+};
+
+static std::vector<BenchQuery> queries;
+
+// 'count' small boxes on a jittered grid over the battlefield, plus a fixed
+// set of random segments (bullet-length and screen-crossing mixed)
+static void seedObstacles(int count) {
+    std::srand(BENCH_SEED);
+    int cols = (int)std::ceil(std::sqrt((double)count));
+    float cellW = 520.0f / cols, cellH = 320.0f / cols;
+
+    std::vector<Obstacle> list;
+    for (int i = 0; i < count; ++i) {
+        float x = 140.0f + (i % cols) * cellW + (std::rand() / (float)RAND_MAX) * cellW * 0.5f;
+        float y = 140.0f + (i / cols) * cellH + (std::rand() / (float)RAND_MAX) * cellH * 0.5f;
+        AABB box = {Fixed::fromFloat(x), Fixed::fromFloat(y),
+                    Fixed::fromFloat(x + cellW * 0.4f), Fixed::fromFloat(y + cellH * 0.4f)};
+        list.push_back({box, OBSTACLE_WALL});
+    }
+    setObstacles(list);
+
+    queries.clear();
+    for (int i = 0; i < QUERY_COUNT; ++i) {
+        float x = 140.0f + std::rand() / (float)RAND_MAX * 520.0f;
+        float y = 140.0f + std::rand() / (float)RAND_MAX * 320.0f;
+        float a = std::rand() / (float)RAND_MAX * 6.2831853f;
+        float len = (i & 1) ? 8.0f : 400.0f;
+        float x1 = x + std::sin(a) * len, y1 = y - std::cos(a) * len;
+        queries.push_back({x, y, x1, y1, Fixed::fromFloat(x), Fixed::fromFloat(y),
+                           Fixed::fromFloat(x1), Fixed::fromFloat(y1)});
+    }
+}
+
+static double benchRaycast(long long ops) {
+    ObstacleHit hit;
+    int hits = 0;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        const BenchQuery& q = queries[i % QUERY_COUNT];
+        hits += raycastObstacles(q.fx0, q.fy0, q.fx1, q.fy1, hit);
+    }
+    double ns = elapsedNs(start);
+    if (hits < 0) std::printf("%d", hits);   // keep the loop observable
+    return ns;
+}
+
+static double benchSweep(long long ops) {
+    ObstacleHit hit;
+    int hits = 0;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        const BenchQuery& q = queries[i % QUERY_COUNT];
+        Fixed half = Fixed::fromInt(18);
+        AABB box = {q.fx0 - half, q.fy0 - half, q.fx0 + half, q.fy0 + half};
+        hits += sweepObstacles(box, Fixed::fromRaw((q.fx1.raw - q.fx0.raw) / 20),
+                               Fixed::fromRaw((q.fy1.raw - q.fy0.raw) / 20), hit);
+    }
+    double ns = elapsedNs(start);
+    if (hits < 0) std::printf("%d", hits);
+    return ns;
+}
+
+// Whole query segment as one bullet move against a target-sized circle at
+// the next query's start
+static double benchSweepCircle(long long ops) {
+    Fixed t;
+    int hits = 0;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        const BenchQuery& q = queries[i % QUERY_COUNT];
+        const BenchQuery& c = queries[(i + 1) % QUERY_COUNT];
+        hits += sweepCircle(q.fx0, q.fy0, q.fx1 - q.fx0, q.fy1 - q.fy0,
+                            c.fx0, c.fy0, Fixed::fromInt(25), t);
+    }
+    double ns = elapsedNs(start);
+    if (hits < 0) std::printf("%d", hits);
+    return ns;
+}
+
+// =====================================================
+// Visibility (fog of war)
+// =====================================================
+
+static int fogViewerCount = 1;
+
+// Viewers drive in circles of different radii around the battlefield, turning
+// a little every tick, so a realistic share of them changes cell or heading
+static double benchFogUpdate(long long ops) {
+    fogClearViewers();
+    for (int i = 0; i < fogViewerCount; ++i) fogAddViewer();
+
+    auto start = BenchClock::now();
+    for (long long tick = 0; tick < ops; ++tick) {
+        for (int i = 0; i < fogViewerCount; ++i) {
+            float phase  = (tick + i * 37) * 0.02f;
+            float radius = 40.0f + (i % 8) * 20.0f;
+            float cx = 400.0f + std::cos(phase) * radius;
+            float cy = 300.0f + std::sin(phase) * radius * 0.8f;
+            fogMoveViewer(i, cx, cy, phase * 57.29578f + 90.0f);
+        }
+        fogUpdate();
+    }
+    return elapsedNs(start);
+}
+
+// Perception queries: every viewer tests a fixed set of points
+static double benchFogQuery(long long ops) {
+    int seen = 0;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        const BenchQuery& q = queries[i % QUERY_COUNT];
+        seen += fogViewerSees((int)(i % fogViewerCount), q.x0, q.y0);
+    }
+    double ns = elapsedNs(start);
+    if (seen < 0) std::printf("%d", seen);
+    return ns;
+}
+
+// =====================================================
+// Event bus
+// =====================================================
+
+constexpr int MAX_CONSUMERS = 8;
+
+static int eventConsumers = 0;
+
+// Publishes one event per op; every consumer drains the bus every 64 events,
+// like a frame-paced reader would
+static double benchEventBus(long long ops) {
+    EventCursor cursors[MAX_CONSUMERS];
+    for (int c = 0; c < eventConsumers; ++c) cursors[c] = gameEvents.subscribe();
+
+    GameEvent e = {};
+    e.type = EVENT_TARGET_HIT;
+    long long seen = 0;
+
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        e.tick = (unsigned long long)i;
+        e.targetHit.score = (int)i;
+        gameEvents.publish(e);
+
+        if (i % 64 == 63) {
+            GameEvent out;
+            for (int c = 0; c < eventConsumers; ++c) {
+                while (gameEvents.poll(cursors[c], out)) ++seen;
+            }
+        }
+    }
+    double ns = elapsedNs(start);
+    if (seen < 0) std::printf("%lld", seen);
+    return ns;
+}
+
+// =====================================================
+// Telemetry
+// =====================================================
+
+constexpr const char* BENCH_TELEMETRY_PATH = "tank_bench_telemetry.tlm";
+
+// One recorded tick with a shot and a small move, the steady-state sim load.
+// The ring is small so the run laps it many times.
+static double benchTelemetryTick(long long ops) {
+    GameEvent e = {};
+    e.type = EVENT_BULLET_FIRED;
+
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        e.tick = (unsigned long long)i;
+        gameEvents.publish(e);
+        telemetryRecordTick((unsigned long long)i, 400.0f + (i % 100) * 0.5f, 300.0f, (float)(i % 72) * 5.0f,
+                            (int)(i / 10), 250);
+    }
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Scheduler
+// =====================================================
+
+static unsigned long long schedTick = 0;
+
+// Game-script-like task: sleeps a pseudo-random 1..64 ticks, forever
+static SimTask benchSleeper(unsigned seed) {
+    for (;;) {
+        seed = seed * 1664525u + 1013904223u;
+        co_await sleep_ticks(1 + (seed >> 26));
+    }
+}
+
+// One sim tick per op; with n sleeping tasks about n / 32 timers expire per tick
+static double benchSchedRun(long long ops) {
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) schedRun(++schedTick);
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Terrain
+// =====================================================
+
+static int benchImpactsPerFrame = 1;
+
+// One frame per op: the sim digs the craters, the GLUT side stamps the
+// decals and uploads the dirty rectangles (null GL)
+static double benchTerrainFrame(long long ops) {
+    terrainReset();
+    terrainClearDecals();
+    unsigned seed = BENCH_SEED;
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        for (int k = 0; k < benchImpactsPerFrame; ++k) {
+            seed = seed * 1664525u + 1013904223u;
+            int col = 70 + (int)((seed >> 8) % 260);    // battlefield cells
+            int row = 70 + (int)((seed >> 20) % 160);
+            terrainImpact(col, row);
+            terrainStampImpact(col, row);
+        }
+        drawTerrain();
+    }
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Transform hierarchy
+// =====================================================
+
+static TransformGraph benchParts;
+static int            benchMovingTanks = 0;
+
+// Tanks of three parts each, like game.cpp's tank hierarchy
+static void buildBenchParts(int tanks) {
+    const Fixed zero = Fixed::fromInt(0), one = Fixed::fromInt(1);
+    tfClear(benchParts);
+    for (int i = 0; i < tanks; ++i) {
+        int hull   = tfAdd(benchParts, -1, Fixed::fromInt(i % 800), Fixed::fromInt(i % 600), 0, one);
+        int turret = tfAdd(benchParts, hull, zero, zero, 0, one);
+        tfAdd(benchParts, turret, zero, Fixed::fromInt(-24), 0, one);
+    }
+    tfUpdate(benchParts);
+}
+
+// One tick per op: the first benchMovingTanks hulls move, then one batch update
+static double benchTransformUpdate(long long ops) {
+    auto start = BenchClock::now();
+    for (long long i = 0; i < ops; ++i) {
+        for (int t = 0; t < benchMovingTanks; ++t) {
+            const TransformNode& hull = benchParts.nodes[t * 3];
+            tfSetLocal(benchParts, t * 3, hull.x + Fixed::fromInt(1), hull.y, (BAngle)(hull.angle + 64));
+        }
+        tfUpdate(benchParts);
+    }
+    return elapsedNs(start);
+}
+
+// =====================================================
+// Main
+// =====================================================
+
+struct SimScale {
+    int bullets;
+    int targets;
+};
+
+static const SimScale SIM_SCALES[] = {
+    {MAX_BULLETS,       NUM_TARGETS},
+    {MAX_BULLETS * 10,  NUM_TARGETS * 10},
+    {MAX_BULLETS * 100, NUM_TARGETS * 100},
+};
+
+static bool matches(const char* name, const char* filter) {
+    return !filter || std::strstr(name, filter) != nullptr;
+}
+
+int main(int argc, char** argv) {
+    // Stress scenarios, drawn into the null backend every frame
+    StressConfig stress;
+    if (!stressParseArgs(argc, argv, stress)) return 1;
+    if (stress.enabled) {
+        initGraphics();
+        return stressRunHeadless(stress, true);
+    }
+
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--reps") && i + 1 < argc) {
+            benchReps = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--min-time-ms") && i + 1 < argc) {
+            benchMinTimeNs = std::atof(argv[++i]) * 1e6;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter <substring>] [--reps <n>] [--min-time-ms <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Stored bytes per entity (a bullet / target also has its bit in the pool's ActiveBits)
+    std::printf("{\n  \"context\": {\"reps\": %d, \"min_time_ms\": %.1f, \"compiler\": \"%s\",\n"
+                "              \"entity_bytes\": {\"tank\": %zu, \"bullet\": %.3f, \"target\": %.3f}},\n"
+                "  \"benchmarks\": [\n", benchReps, benchMinTimeNs / 1e6, __VERSION__,
+                sizeof(Car), sizeof(Bullet) + 1.0 / 8, sizeof(Target) + 1.0 / 8);
+
+    BenchCase bc;
+
+    // Rasterisation kernels
+    for (int len : {20, 100, 500}) {
+        rasterLen = len;
+        std::snprintf(bc.name, sizeof(bc.name), "raster/drawLineDDA/len=%d", len);
+        bc.fn = benchLineDDA;
+        if (matches(bc.name, filter)) runCase(bc);
+
+        std::snprintf(bc.name, sizeof(bc.name), "raster/drawLineBresenham/len=%d", len);
+        bc.fn = benchLineBresenham;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+    for (int r : {4, 20, 200}) {
+        rasterLen = r;
+        std::snprintf(bc.name, sizeof(bc.name), "raster/drawCircleMidpoint/r=%d", r);
+        bc.fn = benchCircleMidpoint;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Heading -> forward vector
+    std::snprintf(bc.name, sizeof(bc.name), "math/fxSinCos");
+    bc.fn = benchFxSinCos;
+    if (matches(bc.name, filter)) runCase(bc);
+
+    std::snprintf(bc.name, sizeof(bc.name), "math/stdSinCos");
+    bc.fn = benchStdSinCos;
+    if (matches(bc.name, filter)) runCase(bc);
+
+    // Full frame at the default entity counts
+    setEntityCounts(MAX_BULLETS, NUM_TARGETS);
+    initGameUncounted();
+    std::snprintf(bc.name, sizeof(bc.name), "render/drawScene");
+    bc.fn = benchDrawScene;
+    if (matches(bc.name, filter)) runCase(bc);
+
+    // Split-screen: same world, one viewport per player
+    for (int players : {2, 3, 4}) {
+        setPlayerCount(players);
+        initGameUncounted();
+        std::snprintf(bc.name, sizeof(bc.name), "render/drawScene/players=%d", players);
+        bc.fn = benchDrawScene;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+    setPlayerCount(1);
+
+    // Simulation and collision kernels at scaled entity counts
+    for (const SimScale& s : SIM_SCALES) {
+        setEntityCounts(s.bullets, s.targets);
+
+        std::snprintf(bc.name, sizeof(bc.name), "sim/updateGame/bullets=%d/targets=%d", s.bullets, s.targets);
+        bc.fn = benchUpdateGame;
+        if (matches(bc.name, filter)) runCase(bc);
+
+        std::snprintf(bc.name, sizeof(bc.name), "sim/spawnBullet/slots=%d", s.bullets);
+        bc.fn = benchSpawnBullet;
+        if (matches(bc.name, filter)) runCase(bc);
+
+        std::snprintf(bc.name, sizeof(bc.name), "sim/resetTargets/targets=%d", s.targets);
+        bc.fn = benchResetTargets;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Stress-sized waves: placement only
+    for (int n : {2000, 5000}) {
+        setEntityCounts(MAX_BULLETS, n);
+
+        std::snprintf(bc.name, sizeof(bc.name), "sim/resetTargets/targets=%d", n);
+        bc.fn = benchResetTargets;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Obstacle queries against growing trees
+    for (int n : {8, 256, 4096}) {
+        seedObstacles(n);
+
+        std::snprintf(bc.name, sizeof(bc.name), "collision/raycast/obstacles=%d", n);
+        bc.fn = benchRaycast;
+        if (matches(bc.name, filter)) runCase(bc);
+
+        std::snprintf(bc.name, sizeof(bc.name), "collision/sweep/obstacles=%d", n);
+        bc.fn = benchSweep;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+    buildLevelObstacles();
+
+    std::snprintf(bc.name, sizeof(bc.name), "collision/sweepCircle");
+    bc.fn = benchSweepCircle;
+    if (matches(bc.name, filter)) runCase(bc);
+
+    // Visibility with the level's obstacles blocking line of sight
+    for (int n : {1, 16, 64}) {
+        fogViewerCount = n;
+
+        std::snprintf(bc.name, sizeof(bc.name), "fog/update/viewers=%d", n);
+        bc.fn = benchFogUpdate;
+        if (matches(bc.name, filter)) runCase(bc);
+
+        std::snprintf(bc.name, sizeof(bc.name), "fog/query/viewers=%d", n);
+        bc.fn = benchFogQuery;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Event bus: publish cost alone, then with frame-paced consumers
+    for (int n : {0, 1, 4}) {
+        eventConsumers = n;
+        std::snprintf(bc.name, sizeof(bc.name), "events/publish/consumers=%d", n);
+        bc.fn = benchEventBus;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Telemetry writer into a memory-mapped ring
+    std::snprintf(bc.name, sizeof(bc.name), "telemetry/recordTick");
+    bc.fn = benchTelemetryTick;
+    if (matches(bc.name, filter) && telemetryOpen(BENCH_TELEMETRY_PATH, 64)) {
+        runCase(bc);
+        telemetryClose();
+        std::remove(BENCH_TELEMETRY_PATH);
+    }
+
+    // Tick scheduler with growing task counts
+    for (int n : {16, 1024, 65536}) {
+        schedTick  = 0;
+        schedReset(schedTick);
+        for (int t = 0; t < n; ++t) schedSpawn(benchSleeper((unsigned)t * 2654435761u));
+
+        std::snprintf(bc.name, sizeof(bc.name), "sched/run/tasks=%d", n);
+        bc.fn = benchSchedRun;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+    schedReset(0);
+
+    // Impacts per frame: 1 ~ 60/s, 8 ~ 500/s
+    for (int n : {1, 8, 64}) {
+        benchImpactsPerFrame = n;
+        std::snprintf(bc.name, sizeof(bc.name), "terrain/frame/impacts=%d", n);
+        bc.fn = benchTerrainFrame;
+        if (matches(bc.name, filter)) runCase(bc);
+    }
+
+    // Tank part matrices: everything moving vs everything parked (cache hits)
+    for (int n : {64, 4096}) {
+        buildBenchParts(n);
+        for (int moving : {n, 0}) {
+            benchMovingTanks = moving;
+            std::snprintf(bc.name, sizeof(bc.name), "transform/update/tanks=%d/moving=%d", n, moving);
+            bc.fn = benchTransformUpdate;
+            if (matches(bc.name, filter)) runCase(bc);
+        }
+    }
+
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
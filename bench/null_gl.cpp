@@ -0,0 +1,73 @@
+// null_gl.cpp
+#include <GL/freeglut.h>   // glutGetProcAddress
+
+#include "null_gl.h"
+
+NullGlCounters nullGl = {0, 0};
+
+#define NULL_GL_CALL()   (++nullGl.calls)
+#define NULL_GL_VERTEX() (++nullGl.calls, ++nullGl.vertices)
+
+// glDrawArrays adds its vertex count to 'vertices' as well
+
+extern "C" {
+
+// ---- GL ----
+void APIENTRY glBegin(GLenum)                                   { NULL_GL_CALL(); }
+void APIENTRY glEnd()                                           { NULL_GL_CALL(); }
+void APIENTRY glVertex2i(GLint, GLint)                          { NULL_GL_VERTEX(); }
+void APIENTRY glVertex2f(GLfloat, GLfloat)                      { NULL_GL_VERTEX(); }
+void APIENTRY glColor3f(GLfloat, GLfloat, GLfloat)              { NULL_GL_CALL(); }
+void APIENTRY glColor3fv(const GLfloat*)                        { NULL_GL_CALL(); }
+void APIENTRY glColor4fv(const GLfloat*)                        { NULL_GL_CALL(); }
+void APIENTRY glColor4f(GLfloat, GLfloat, GLfloat, GLfloat)     { NULL_GL_CALL(); }
+void APIENTRY glClear(GLbitfield)                               { NULL_GL_CALL(); }
+void APIENTRY glClearColor(GLclampf, GLclampf, GLclampf, GLclampf) { NULL_GL_CALL(); }
+void APIENTRY glEnable(GLenum)                                  { NULL_GL_CALL(); }
+void APIENTRY glDisable(GLenum)                                 { NULL_GL_CALL(); }
+GLboolean APIENTRY glIsEnabled(GLenum)                          { NULL_GL_CALL(); return GL_FALSE; }
+void APIENTRY glBlendFunc(GLenum, GLenum)                       { NULL_GL_CALL(); }
+void APIENTRY glLineWidth(GLfloat)                              { NULL_GL_CALL(); }
+void APIENTRY glMatrixMode(GLenum)                              { NULL_GL_CALL(); }
+void APIENTRY glLoadIdentity()                                  { NULL_GL_CALL(); }
+void APIENTRY glPushMatrix()                                    { NULL_GL_CALL(); }
+void APIENTRY glPopMatrix()                                     { NULL_GL_CALL(); }
+void APIENTRY glTranslatef(GLfloat, GLfloat, GLfloat)           { NULL_GL_CALL(); }
+void APIENTRY glRotatef(GLfloat, GLfloat, GLfloat, GLfloat)     { NULL_GL_CALL(); }
+void APIENTRY glScalef(GLfloat, GLfloat, GLfloat)               { NULL_GL_CALL(); }
+void APIENTRY glMultMatrixf(const GLfloat*)                     { NULL_GL_CALL(); }
+void APIENTRY glRasterPos2f(GLfloat, GLfloat)                   { NULL_GL_CALL(); }
+void APIENTRY glEnableClientState(GLenum)                       { NULL_GL_CALL(); }
+void APIENTRY glDisableClientState(GLenum)                      { NULL_GL_CALL(); }
+void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid*) { NULL_GL_CALL(); }
+void APIENTRY glDrawArrays(GLenum, GLint, GLsizei count)        { NULL_GL_CALL(); nullGl.vertices += count; }
+void APIENTRY glLoadMatrixf(const GLfloat*)                     { NULL_GL_CALL(); }
+void APIENTRY glViewport(GLint, GLint, GLsizei, GLsizei)        { NULL_GL_CALL(); }
+const GLubyte* APIENTRY glGetString(GLenum)                     { NULL_GL_CALL(); return nullptr; }   // no timer queries: dynres falls back
+void APIENTRY glCopyTexSubImage2D(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei) { NULL_GL_CALL(); }
+void APIENTRY glTexCoord2f(GLfloat, GLfloat)                    { NULL_GL_CALL(); }
+void APIENTRY glGenTextures(GLsizei n, GLuint* textures)        { NULL_GL_CALL(); for (GLsizei i = 0; i < n; ++i) textures[i] = i + 1; }
+void APIENTRY glBindTexture(GLenum, GLuint)                     { NULL_GL_CALL(); }
+void APIENTRY glTexParameteri(GLenum, GLenum, GLint)            { NULL_GL_CALL(); }
+void APIENTRY glPixelStorei(GLenum, GLint)                      { NULL_GL_CALL(); }
+void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*) { NULL_GL_CALL(); }
+void APIENTRY glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const GLvoid*) { NULL_GL_CALL(); }
+GLuint APIENTRY glGenLists(GLsizei)                             { NULL_GL_CALL(); return 1; }
+void APIENTRY glNewList(GLuint, GLenum)                         { NULL_GL_CALL(); }
+void APIENTRY glEndList()                                       { NULL_GL_CALL(); }
+void APIENTRY glCallList(GLuint)                                { NULL_GL_CALL(); }
+
+// ---- GLU ----
+void APIENTRY gluOrtho2D(GLdouble, GLdouble, GLdouble, GLdouble) { NULL_GL_CALL(); }
+
+// ---- GLUT ----
+void* glutBitmapHelvetica18 = nullptr;
+void* glutBitmap8By13       = nullptr;   // profiler overlay, viewport captions
+
+void FGAPIENTRY glutBitmapCharacter(void*, int)                 { NULL_GL_CALL(); }
+void FGAPIENTRY glutPostRedisplay()                             { NULL_GL_CALL(); }
+void FGAPIENTRY glutSwapBuffers()                               { NULL_GL_CALL(); }
+void FGAPIENTRY glutTimerFunc(unsigned int, void (*)(int), int) { NULL_GL_CALL(); }
+GLUTproc FGAPIENTRY glutGetProcAddress(const char*)             { NULL_GL_CALL(); return nullptr; }
+
+} // extern "C"
@@ -0,0 +1,23 @@
+// null_gl.h
+#ifndef NULL_GL_H
+#define NULL_GL_H
+
+// Counting "null" GL / GLU / GLUT backend for the benchmarks.
+//
+// null_gl.cpp defines every GL entry point the game uses as a function that
+// only bumps these counters, so the benchmark binary links without libGL,
+// needs no window and measures the CPU side of the draw code only.
+
+struct NullGlCounters {
+    long long calls;      // every GL / GLU / GLUT call
+    long long vertices;   // glVertex* calls
+};
+
+extern NullGlCounters nullGl;
+
+inline void resetNullGl() {
+    nullGl.calls    = 0;
+    nullGl.vertices = 0;
+}
+
+#endif // NULL_GL_H
@@ -0,0 +1,106 @@
+// compact.h
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "fixed.h"   // Fixed
+
+// Compact encodings of the entity state (Car, Bullet, Target in game.h).
+//
+// Entities are stored small and unpacked to Fixed where the sim does math on
+// them: positions as 16-bit coordinates of the known play field, tank speed
+// as 16 bits, headings as BAngle, active flags as one bit per pool slot and
+// whatever is the same for every entity of a type (bullet speed, target
+// radius) as a constant of the type. A pool of a million bullets is 6 MB
+// plus 125 KB of bits instead of 20 MB.
+//
+// Encoding rounds to the nearest step and saturates at the range, so a
+// stored value is within half a step of what the sim computed.
+
+// A world coordinate, 0 .. 1024 px in 1/64 px steps (unsigned Q10.6).
+// Holds the battlefield (INNER_* bounds, 140 .. 660 x 140 .. 460) and the
+// whole window
+struct FieldCoord {
+    uint16_t q;
+
+    static constexpr int FRAC_BITS = 6;
+    static constexpr int SHIFT     = Fixed::FRAC_BITS - FRAC_BITS;
+
+    static constexpr FieldCoord fromFixed(Fixed v) {
+        int32_t q = (v.raw + (1 << (SHIFT - 1))) >> SHIFT;
+        return {(uint16_t)std::clamp<int32_t>(q, 0, UINT16_MAX)};
+    }
+
+    constexpr Fixed toFixed() const { return Fixed::fromRaw((int32_t)q << SHIFT); }
+    constexpr float toFloat() const { return q * (1.0f / (1 << FRAC_BITS)); }
+};
+
+// Tank speed in px per tick, -8 .. 8 in 1/4096 px steps (signed Q3.12)
+struct PackedSpeed {
+    int16_t q;
+
+    static constexpr int FRAC_BITS = 12;
+    static constexpr int SHIFT     = Fixed::FRAC_BITS - FRAC_BITS;
+
+    static constexpr PackedSpeed fromFixed(Fixed v) {
+        int32_t q = (v.raw + (1 << (SHIFT - 1))) >> SHIFT;
+        return {(int16_t)std::clamp<int32_t>(q, INT16_MIN, INT16_MAX)};
+    }
+
+    constexpr Fixed toFixed() const { return Fixed::fromRaw((int32_t)q << SHIFT); }
+};
+
+// Half a FieldCoord step: how far encoding can move a position
+constexpr Fixed FIELD_ROUNDING = Fixed::fromRaw(1 << (FieldCoord::SHIFT - 1));
+
+// Active flags of an entity pool, one bit per slot
+struct ActiveBits {
+    std::vector<uint64_t> words;
+
+    // 'slots' slots, all inactive
+    static ActiveBits withSlots(int slots) {
+        ActiveBits bits;
+        bits.resize(slots);
+        return bits;
+    }
+
+    // Every slot inactive
+    void resize(int slots) { words.assign((size_t)(slots + 63) / 64, 0); }
+    void clear()           { std::fill(words.begin(), words.end(), 0); }
+
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    void set(int i)        { words[i >> 6] |= (uint64_t)1 << (i & 63); }
+    void reset(int i)      { words[i >> 6] &= ~((uint64_t)1 << (i & 63)); }
+
+    int count() const {
+        int n = 0;
+        for (uint64_t w : words) n += std::popcount(w);
+        return n;
+    }
+
+    // Lowest inactive slot below 'slots', -1 if all are active
+    int firstClear(int slots) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            if (~words[w] == 0) continue;
+            int i = (int)(w * 64) + std::countr_one(words[w]);
+            return i < slots ? i : -1;
+        }
+        return -1;
+    }
+
+    // f(i) for every active slot, in ascending order; f may reset slot i
+    template <class F>
+    void forEach(F&& f) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                f((int)(w * 64) + std::countr_zero(bits));
+            }
+        }
+    }
+};
+
+#endif // COMPACT_H
@@ -0,0 +1,285 @@
+// dynres.cpp
+#include <GL/freeglut.h>   // glutGetProcAddress
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "dynres.h"
+#include "game.h"       // WIDTH, HEIGHT (world coordinates)
+#include "glstate.h"
+#include "profiler.h"   // must stay last: hooks GL calls when profiling
+
+// =====================================================
+// State
+// =====================================================
+
+static int   windowW = WIDTH;
+static int   windowH = HEIGHT;
+static bool  enabled = true;
+static float scale   = 1.0f;
+
+// Viewport the current frame's scene was drawn into
+static int  sceneW = WIDTH;
+static int  sceneH = HEIGHT;
+static bool subViewport = false;   // a split-screen viewport is set
+
+// Rolling frame cost at the current scale
+static float samples[DYNRES_WINDOW];
+static int   sampleCount = 0;
+static int   sampleNext  = 0;
+static float sampleSum   = 0.0f;
+
+// Scene copy (power-of-two size, GL 1.x)
+static GLuint sceneTexture = 0;
+static int    textureW = 0;
+static int    textureH = 0;
+
+// GPU frame timer: GL_TIME_ELAPSED queries (GL 3.3, ARB_timer_query or
+// EXT_timer_query), reached through glutGetProcAddress as the GL 1.x headers
+// and opengl32 do not declare them. Results are read a few frames late and
+// only once available, so the CPU never waits for the GPU.
+constexpr GLenum GPU_TIME_ELAPSED           = 0x88BF;
+constexpr GLenum GPU_QUERY_RESULT           = 0x8866;
+constexpr GLenum GPU_QUERY_RESULT_AVAILABLE = 0x8867;
+constexpr int    GPU_QUERIES                = 4;   // frames in flight
+
+typedef void (APIENTRY* GenQueriesProc)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* BeginQueryProc)(GLenum target, GLuint id);
+typedef void (APIENTRY* EndQueryProc)(GLenum target);
+typedef void (APIENTRY* GetQueryObjectivProc)(GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRY* GetQueryObjectui64vProc)(GLuint id, GLenum pname, std::uint64_t* params);
+
+static GenQueriesProc          genQueries          = nullptr;
+static BeginQueryProc          beginQuery          = nullptr;
+static EndQueryProc            endQuery            = nullptr;
+static GetQueryObjectivProc    getQueryObjectiv    = nullptr;
+static GetQueryObjectui64vProc getQueryObjectui64v = nullptr;
+
+static bool   timerChecked = false;
+static bool   timerUsable  = false;
+static GLuint queries[GPU_QUERIES];
+static bool   queryPending[GPU_QUERIES];
+static int    queryNext    = 0;
+static bool   queryRunning = false;
+static float  gpuMs        = 0.0f;   // newest result, 0 until the first one arrives
+
+// Swap-to-swap interval (fallback without timer queries)
+static std::chrono::steady_clock::time_point lastFrameEnd;
+static bool haveLastFrameEnd = false;
+
+static int nextPowerOfTwo(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+static void setScale(float s) {
+    scale = s;
+    sampleCount = 0;   // samples taken at the old scale no longer apply
+    sampleNext  = 0;
+    sampleSum   = 0.0f;
+}
+
+// --- GPU frame timer ---
+
+static bool hasExtension(const char* name) {
+    const char* list = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!list) return false;
+    size_t len = std::strlen(name);
+    for (const char* p = std::strstr(list, name); p; p = std::strstr(p + len, name)) {
+        if ((p == list || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0')) return true;
+    }
+    return false;
+}
+
+static void initTimer() {
+    timerChecked = true;
+
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    int major = 0, minor = 0;
+    if (version) {
+        major = std::atoi(version);
+        const char* dot = std::strchr(version, '.');
+        if (dot) minor = std::atoi(dot + 1);
+    }
+    bool arb = major > 3 || (major == 3 && minor >= 3) || hasExtension("GL_ARB_timer_query");
+    bool ext = !arb && hasExtension("GL_EXT_timer_query");
+    if (!arb && !ext) return;
+
+    // GL 1.5 query objects; the 64-bit result getter is the only EXT-suffixed entry
+    genQueries          = reinterpret_cast<GenQueriesProc>(glutGetProcAddress("glGenQueries"));
+    beginQuery          = reinterpret_cast<BeginQueryProc>(glutGetProcAddress("glBeginQuery"));
+    endQuery            = reinterpret_cast<EndQueryProc>(glutGetProcAddress("glEndQuery"));
+    getQueryObjectiv    = reinterpret_cast<GetQueryObjectivProc>(glutGetProcAddress("glGetQueryObjectiv"));
+    getQueryObjectui64v = reinterpret_cast<GetQueryObjectui64vProc>(
+        glutGetProcAddress(ext ? "glGetQueryObjectui64vEXT" : "glGetQueryObjectui64v"));
+    if (!genQueries || !beginQuery || !endQuery || !getQueryObjectiv || !getQueryObjectui64v) return;
+
+    genQueries(GPU_QUERIES, queries);
+    timerUsable = true;
+}
+
+// Reads the query in 'slot' if the GPU has finished it; false while pending
+static bool collectQuery(int slot) {
+    if (!queryPending[slot]) return true;
+    GLint available = 0;
+    getQueryObjectiv(queries[slot], GPU_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    std::uint64_t ns = 0;
+    getQueryObjectui64v(queries[slot], GPU_QUERY_RESULT, &ns);
+    gpuMs = (float)(ns / 1.0e6);
+    queryPending[slot] = false;
+    return true;
+}
+
+// =====================================================
+// Frame hooks
+// =====================================================
+
+void dynresReshape(int width, int height) {
+    windowW = std::max(1, width);
+    windowH = std::max(1, height);
+    glViewport(0, 0, windowW, windowH);
+}
+
+void dynresBeginScene() {
+    sceneW = std::max(1, (int)std::lround(windowW * scale));
+    sceneH = std::max(1, (int)std::lround(windowH * scale));
+    subViewport = false;
+    glViewport(0, 0, sceneW, sceneH);
+}
+
+void dynresSubViewport(float x, float y, float w, float h) {
+    // Edges rounded, not sizes: neighbouring viewports share them
+    int x0 = (int)std::lround(sceneW * x), x1 = (int)std::lround(sceneW * (x + w));
+    int y0 = (int)std::lround(sceneH * y), y1 = (int)std::lround(sceneH * (y + h));
+    glViewport(x0, y0, std::max(1, x1 - x0), std::max(1, y1 - y0));
+    subViewport = true;
+}
+
+void dynresEndScene() {
+    if (sceneW == windowW && sceneH == windowH) {   // drawn at native size
+        if (subViewport) glViewport(0, 0, windowW, windowH);
+        return;
+    }
+
+    PROFILE_SCOPE("dynresUpscale");
+
+    if (!sceneTexture) glGenTextures(1, &sceneTexture);
+    gsBindTexture2D(sceneTexture);
+
+    // (Re)allocate when the window outgrew the texture; the copy fills it
+    if (textureW < windowW || textureH < windowH) {
+        textureW = nextPowerOfTwo(windowW);
+        textureH = nextPowerOfTwo(windowH);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureW, textureH, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    // Back buffer (lower-left scene rectangle) -> texture
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, sceneW, sceneH);
+
+    // Stretch it over the whole window, in world coordinates
+    const float s = (float)sceneW / textureW;
+    const float t = (float)sceneH / textureH;
+    static const GLfloat WHITE[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    glViewport(0, 0, windowW, windowH);
+    gsMatrixMode(GL_MODELVIEW);
+    gsLoadIdentity();
+    gsDisable(GL_BLEND);
+    gsEnable(GL_TEXTURE_2D);
+    gsColor4fv(WHITE);
+    glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(0.0f, 0.0f);
+        glTexCoord2f(s,    0.0f); glVertex2f((float)WIDTH, 0.0f);
+        glTexCoord2f(s,    t);    glVertex2f((float)WIDTH, (float)HEIGHT);
+        glTexCoord2f(0.0f, t);    glVertex2f(0.0f, (float)HEIGHT);
+    glEnd();
+    gsDisable(GL_TEXTURE_2D);
+}
+
+void dynresBeginFrame() {
+    if (!enabled) return;
+    if (!timerChecked) initTimer();
+    if (!timerUsable) return;
+
+    // Every query still in flight: leave this frame untimed rather than wait
+    if (!collectQuery(queryNext)) return;
+    beginQuery(GPU_TIME_ELAPSED, queries[queryNext]);
+    queryRunning = true;
+}
+
+void dynresFrameTime(float cpuMs) {
+    if (queryRunning) {
+        endQuery(GPU_TIME_ELAPSED);
+        queryPending[queryNext] = true;
+        queryNext = (queryNext + 1) % GPU_QUERIES;
+        queryRunning = false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    float intervalMs = haveLastFrameEnd ? std::chrono::duration<float, std::milli>(now - lastFrameEnd).count() : 0.0f;
+    lastFrameEnd = now;
+    haveLastFrameEnd = true;
+    if (!enabled) return;
+
+    // GPU cost: the newest finished query, oldest first so the newest wins;
+    // without timer queries, what the swap-to-swap interval leaves after
+    // the CPU work (an upper bound: it includes any vsync wait)
+    float gpu;
+    if (timerUsable) {
+        for (int i = 0; i < GPU_QUERIES; ++i) collectQuery((queryNext + i) % GPU_QUERIES);
+        gpu = gpuMs;
+    } else {
+        if (intervalMs == 0.0f) return;
+        gpu = std::max(0.0f, intervalMs - cpuMs);
+    }
+
+    // CPU and GPU work of consecutive frames overlap, so the slower side
+    // sets the frame rate
+    float ms = std::max(cpuMs, gpu);
+
+    if (sampleCount == DYNRES_WINDOW) sampleSum -= samples[sampleNext];
+    else                              ++sampleCount;
+    samples[sampleNext] = ms;
+    sampleSum += ms;
+    sampleNext = (sampleNext + 1) % DYNRES_WINDOW;
+
+    // Decide only on a full window measured at the current scale
+    if (sampleCount < DYNRES_WINDOW) return;
+    float average = sampleSum / sampleCount;
+
+    if (average > DYNRES_BUDGET_MS) {
+        if (scale > DYNRES_MIN_SCALE) setScale(std::max(DYNRES_MIN_SCALE, scale - DYNRES_SCALE_STEP));
+    } else if (scale < 1.0f) {
+        // Pixel work grows with the area; step up only if that still fits with headroom
+        float up = std::min(1.0f, scale + DYNRES_SCALE_STEP);
+        float predicted = average * (up * up) / (scale * scale);
+        if (predicted < DYNRES_BUDGET_MS * 0.85f) setScale(up);
+    }
+}
+
+// =====================================================
+// Control
+// =====================================================
+
+void dynresToggle() {
+    enabled = !enabled;
+    setScale(1.0f);
+}
+
+bool dynresEnabled() {
+    return enabled;
+}
+
+float dynresScale() {
+    return scale;
+}
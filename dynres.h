@@ -0,0 +1,55 @@
+// dynres.h
+#ifndef DYNRES_H
+#define DYNRES_H
+
+// Dynamic resolution scaling (GLUT thread).
+//
+// The world layers are drawn into a smaller viewport of the back buffer,
+// copied into a texture (glCopyTexSubImage2D, GL 1.1, no extensions) and
+// stretched over the whole window; the HUD is then drawn on top at native
+// resolution. The projection (gluOrtho2D over WIDTH x HEIGHT) never changes,
+// so gameplay and world coordinates are unaffected.
+//
+// The scale follows a rolling average of the measured frame cost: it drops a
+// step when the average is over budget and rises a step when the larger
+// image is predicted to fit comfortably. At full scale nothing is copied.
+//
+// A frame's cost is the larger of its CPU time and its GPU time. The GPU time
+// comes from GL_TIME_ELAPSED queries where the driver has them, read back a
+// few frames late; otherwise it is estimated as the swap-to-swap interval
+// minus the CPU time. Nothing waits for the GPU (no glFinish).
+
+constexpr float DYNRES_BUDGET_MS   = 12.0f;    // frame cost target (60 FPS frame = 16.7 ms)
+constexpr float DYNRES_MIN_SCALE   = 0.5f;
+constexpr float DYNRES_SCALE_STEP  = 0.125f;
+constexpr int   DYNRES_WINDOW      = 30;       // frames in the rolling average (refilled after a change)
+
+// --- Frame hooks (Defined in dynres.cpp) ---
+
+// Start of the frame's GL work: starts the GPU timer query if one is free
+void dynresBeginFrame();
+
+// Window size (glutReshapeFunc); the GL viewport follows it
+void dynresReshape(int width, int height);
+
+// Before the world layers: scaled viewport
+void dynresBeginScene();
+
+// Part of the scene (a split-screen viewport), in fractions of the window
+// from its lower left corner; between dynresBeginScene and dynresEndScene
+void dynresSubViewport(float x, float y, float w, float h);
+
+// After the world layers: copy + upscale to the window, native viewport for the HUD
+void dynresEndScene();
+
+// Right before the swap, with the frame's CPU time (record + submit): ends the
+// GPU timer query and feeds the frame cost to the controller
+void dynresFrameTime(float cpuMs);
+
+// --- Control ---
+
+void  dynresToggle();          // automatic scaling on / off (off = full resolution)
+bool  dynresEnabled();
+float dynresScale();           // current internal resolution, 1.0 = native
+
+#endif // DYNRES_H
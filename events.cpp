@@ -0,0 +1,57 @@
+// events.cpp
+#include <cstring>
+#include <type_traits>
+
+#include "events.h"
+
+static_assert(std::is_trivially_copyable<GameEvent>::value, "events are copied word by word");
+
+EventBus gameEvents;
+
+void EventBus::publish(const GameEvent& e) {
+    uint32_t words[WORDS] = {};
+    std::memcpy(words, &e, sizeof(GameEvent));
+
+    unsigned long long pos = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos % EVENT_BUS_SIZE];
+
+    // Mark the slot busy before touching the payload (seqlock write side)
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < WORDS; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.seq.store(pos + 1, std::memory_order_release);
+
+    head.store(pos + 1, std::memory_order_release);
+}
+
+EventCursor EventBus::subscribe() const {
+    return {head.load(std::memory_order_acquire), 0};
+}
+
+bool EventBus::poll(EventCursor& cursor, GameEvent& out) const {
+    for (;;) {
+        unsigned long long published = head.load(std::memory_order_acquire);
+        if (cursor.next >= published) return false;
+
+        // Lapped: the oldest events still in the ring start at published - size
+        if (published - cursor.next > EVENT_BUS_SIZE) {
+            cursor.dropped += published - EVENT_BUS_SIZE - cursor.next;
+            cursor.next = published - EVENT_BUS_SIZE;
+        }
+
+        const Slot& slot = slots[cursor.next % EVENT_BUS_SIZE];
+        unsigned long long seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != cursor.next + 1) continue;   // being rewritten by a newer lap
+
+        uint32_t words[WORDS];
+        for (int i = 0; i < WORDS; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+        // Seqlock read side: the copy is valid only if the slot did not change meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+        std::memcpy(&out, words, sizeof(GameEvent));
+        ++cursor.next;
+        return true;
+    }
+}
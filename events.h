@@ -0,0 +1,104 @@
+// events.h
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <atomic>
+#include <cstdint>
+
+// Game event bus.
+//
+// The sim thread publishes typed events (bullet fired, target hit, shell
+// impact, wave spawned, game over) into a lock-free broadcast ring. Every consumer (HUD
+// effects on the GLUT thread, telemetry, replay ...) owns an EventCursor and
+// reads at its own pace; the producer never waits for anyone, so consumers add
+// no work to the tick.
+//
+// A consumer that falls more than EVENT_BUS_SIZE events behind skips the
+// events that were overwritten and counts them in EventCursor::dropped.
+
+enum GameEventType : uint8_t {
+    EVENT_BULLET_FIRED,
+    EVENT_TARGET_HIT,
+    EVENT_SHELL_IMPACT,
+    EVENT_WAVE_SPAWNED,
+    EVENT_GAME_OVER
+};
+
+struct BulletFiredEvent {
+    int   slot;          // index into the bullet pool
+    float x, y;          // muzzle position
+    float vx, vy;
+};
+
+struct TargetHitEvent {
+    int   target;        // index into the target pool
+    int   bullet;
+    float x, y;          // target centre
+    int   score;         // score after the hit
+};
+
+struct ShellImpactEvent {
+    float x, y;          // where the shell came down
+    int   col, row;      // crater cell in the terrain grid (terrain.h)
+};
+
+struct WaveSpawnedEvent {
+    int wave;            // 1 for the first wave of a round
+    int targets;
+};
+
+struct GameOverEvent {
+    int finalScore;
+};
+
+struct GameEvent {
+    unsigned long long tick;   // sim tick the event happened in
+    GameEventType      type;
+    union {
+        BulletFiredEvent bulletFired;
+        TargetHitEvent   targetHit;
+        ShellImpactEvent shellImpact;
+        WaveSpawnedEvent waveSpawned;
+        GameOverEvent    gameOver;
+    };
+};
+
+// Read position of one consumer
+struct EventCursor {
+    unsigned long long next;      // sequence number of the next event to read
+    unsigned long long dropped;   // events lost because the consumer fell behind
+};
+
+constexpr unsigned EVENT_BUS_SIZE = 1024;   // power of two
+
+// Single producer / multi consumer broadcast ring
+struct EventBus {
+    // Sim thread only
+    void publish(const GameEvent& e);
+
+    // Any thread: a cursor that starts with the next published event
+    EventCursor subscribe() const;
+
+    // Consumer thread: copies the next event into 'out'; false when caught up
+    bool poll(EventCursor& cursor, GameEvent& out) const;
+
+    // --- Storage ---
+    // Each slot carries the sequence number of the event in it (+1, 0 while
+    // it is being written). The payload is stored as relaxed atomic words, so
+    // a reader racing with a writer that lapped it reads a torn copy, notices
+    // the changed sequence number and retries, without undefined behaviour.
+    static constexpr int WORDS = (sizeof(GameEvent) + 3) / 4;
+
+    struct Slot {
+        std::atomic<unsigned long long> seq{0};
+        std::atomic<uint32_t>           words[WORDS];
+    };
+
+    Slot                            slots[EVENT_BUS_SIZE];
+    std::atomic<unsigned long long> head{0};   // events published so far
+};
+
+// Bus for everything updateGame() reports (Defined in events.cpp)
+extern EventBus gameEvents;
+
+#endif // EVENTS_H
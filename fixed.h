@@ -0,0 +1,184 @@
+// fixed.h
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cstdint>
+
+// Deterministic math for the simulation.
+//
+// Sim state (Car, Bullet, Target, obstacles) is stored in Fixed, a Q16.16
+// number: 16 integer bits including the sign (+-32767 px, plenty for an
+// 800 x 600 world) and 16 fraction bits (1/65536 px). Arithmetic is integer
+// only, so a tick produces the same bits on every compiler, optimisation
+// level and CPU -- the precondition for lockstep, replays and server checks.
+// Floats appear only at the edges: rendering, telemetry and tuning constants
+// folded at compile time.
+//
+// Headings are binary angles (BAngle): a full turn is 65536 units and wraps
+// for free in uint16 arithmetic. fxSin / fxCos read a quarter-wave table that
+// is generated at compile time, so no libm call is involved either.
+
+// Built only through the from* factories: no implicit conversion from
+// int / float, so a float can never land in 'raw' by accident.
+struct Fixed {
+    int32_t raw;
+
+    static constexpr int     FRAC_BITS = 16;
+    static constexpr int32_t ONE       = 1 << FRAC_BITS;
+
+    Fixed() = default;
+
+    static constexpr Fixed fromRaw(int32_t raw) {
+        Fixed f{};
+        f.raw = raw;
+        return f;
+    }
+    static constexpr Fixed fromInt(int value) { return fromRaw(value * ONE); }
+
+    // Nearest value; for constants, input and test setup (not inside a tick)
+    static constexpr Fixed fromFloat(float value) {
+        return fromRaw((int32_t)(value * ONE + (value >= 0.0f ? 0.5f : -0.5f)));
+    }
+
+    constexpr float toFloat() const { return raw * (1.0f / ONE); }
+    constexpr int   floorInt() const { return raw >> FRAC_BITS; }
+
+    friend constexpr auto operator<=>(Fixed, Fixed) = default;
+
+    constexpr Fixed& operator+=(Fixed b) { raw += b.raw; return *this; }
+    constexpr Fixed& operator-=(Fixed b) { raw -= b.raw; return *this; }
+};
+
+constexpr Fixed operator+(Fixed a, Fixed b) { return Fixed::fromRaw(a.raw + b.raw); }
+constexpr Fixed operator-(Fixed a, Fixed b) { return Fixed::fromRaw(a.raw - b.raw); }
+constexpr Fixed operator-(Fixed a)          { return Fixed::fromRaw(-a.raw); }
+constexpr Fixed operator*(Fixed a, int k)   { return Fixed::fromRaw(a.raw * k); }
+
+// Rounds toward minus infinity (arithmetic shift)
+constexpr Fixed operator*(Fixed a, Fixed b) {
+    return Fixed::fromRaw((int32_t)(((int64_t)a.raw * b.raw) >> Fixed::FRAC_BITS));
+}
+
+// Truncates toward zero and saturates instead of wrapping (b must not be 0)
+constexpr Fixed operator/(Fixed a, Fixed b) {
+    int64_t q = ((int64_t)a.raw * Fixed::ONE) / b.raw;
+    if (q > INT32_MAX) q = INT32_MAX;
+    if (q < INT32_MIN) q = INT32_MIN;
+    return Fixed::fromRaw((int32_t)q);
+}
+
+// Squared length in Q32.32 (does not fit Q16.16 beyond ~181 px)
+constexpr int64_t fxLengthSq(Fixed dx, Fixed dy) {
+    return (int64_t)dx.raw * dx.raw + (int64_t)dy.raw * dy.raw;
+}
+
+// floor(sqrt(v)), bit by bit
+constexpr uint64_t isqrt64(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit  = uint64_t(1) << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= root + bit) {
+            v   -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// =====================================================
+// Binary angles + sine table
+// =====================================================
+
+using BAngle = uint16_t;
+
+constexpr int BANGLE_TURN = 65536;
+
+constexpr BAngle bangleFromDegrees(float degrees) {
+    float units = degrees * (BANGLE_TURN / 360.0f);
+    return (BAngle)(int32_t)(units + (units >= 0.0f ? 0.5f : -0.5f));
+}
+
+constexpr float bangleToDegrees(BAngle angle) {
+    return angle * (360.0f / BANGLE_TURN);
+}
+
+constexpr int SIN_TABLE_BITS = 10;                    // 1024 steps per quarter turn (~0.09 degrees)
+constexpr int SIN_QUARTER    = 1 << SIN_TABLE_BITS;
+
+struct SinTable {
+    int32_t quarter[SIN_QUARTER + 1];   // sin over [0, 90] degrees, Q16.16
+};
+
+// Taylor series on [0, pi/2]; every step is an exactly rounded double
+// operation, so all compilers fold it to the same table
+constexpr double constexprSin(double x) {
+    double term = x, sum = x;
+    for (int n = 1; n <= 12; ++n) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr SinTable makeSinTable() {
+    SinTable table = {};
+    for (int i = 0; i <= SIN_QUARTER; ++i) {
+        double s = constexprSin(i * (3.14159265358979323846 / 2.0) / SIN_QUARTER);
+        table.quarter[i] = (int32_t)(s * Fixed::ONE + 0.5);
+    }
+    return table;
+}
+
+inline constexpr SinTable SIN_TABLE = makeSinTable();
+
+static_assert(SIN_TABLE.quarter[0] == 0 && SIN_TABLE.quarter[SIN_QUARTER] == Fixed::ONE,
+              "sine table endpoints");
+static_assert(SIN_TABLE.quarter[SIN_QUARTER / 2] == 46341, "sin(45 degrees) = 0.70711");
+
+constexpr Fixed fxSin(BAngle angle) {
+    int step     = angle >> (16 - 2 - SIN_TABLE_BITS);    // 4 * SIN_QUARTER steps per turn
+    int quadrant = step >> SIN_TABLE_BITS;
+    int i        = step & (SIN_QUARTER - 1);
+    switch (quadrant) {
+    case 0:  return Fixed::fromRaw(SIN_TABLE.quarter[i]);
+    case 1:  return Fixed::fromRaw(SIN_TABLE.quarter[SIN_QUARTER - i]);
+    case 2:  return Fixed::fromRaw(-SIN_TABLE.quarter[i]);
+    default: return Fixed::fromRaw(-SIN_TABLE.quarter[SIN_QUARTER - i]);
+    }
+}
+
+constexpr Fixed fxCos(BAngle angle) {
+    return fxSin((BAngle)(angle + BANGLE_TURN / 4));
+}
+
+// Angle of the vector (x, y), i.e. atan2(y, x), to table precision. Binary
+// search for atan(small / large) in the first octant, then mirrored.
+constexpr BAngle fxAtan2(Fixed y, Fixed x) {
+    int64_t ax = x.raw < 0 ? -(int64_t)x.raw : x.raw;
+    int64_t ay = y.raw < 0 ? -(int64_t)y.raw : y.raw;
+    if (ax == 0 && ay == 0) return 0;
+
+    bool    steep = ay > ax;
+    int64_t lo    = steep ? ax : ay;
+    int64_t hi    = steep ? ay : ax;
+
+    // Largest step s <= 45 degrees with tan(s) <= lo / hi
+    int a = 0, b = SIN_QUARTER / 2;
+    while (a < b) {
+        int m = (a + b + 1) / 2;
+        if (SIN_TABLE.quarter[m] * hi <= SIN_TABLE.quarter[SIN_QUARTER - m] * lo) a = m;
+        else                                                                         b = m - 1;
+    }
+
+    int32_t units = a << (16 - 2 - SIN_TABLE_BITS);
+    if (steep)      units = BANGLE_TURN / 4 - units;
+    if (x.raw < 0)  units = BANGLE_TURN / 2 - units;
+    if (y.raw < 0)  units = -units;
+    return (BAngle)units;
+}
+
+#endif // FIXED_H
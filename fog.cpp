@@ -0,0 +1,409 @@
+// fog.cpp
+#include <GL/glut.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "fog.h"
+#include "glstate.h"
+#include "obstacles.h"  // raycastObstacles (line of sight)
+#include "profiler.h"   // must stay last: hooks GL calls when profiling
+
+#ifndef M_PI
+#define M_PI 3.14159265359f
+#endif
+
+// =====================================================
+// Viewers
+// =====================================================
+
+// Rays sit on a fixed lattice of directions, FOG_RAYS_PER_BUCKET per heading
+// bucket, so turning by a bucket swaps a few rays at the cone's edges and
+// keeps the rest. 5/3 degrees apart: 6.4 px at full range, under 3/4 of a
+// cell, and each ray marks every cell it crosses, so no cell inside the cone
+// is skipped.
+constexpr int FOG_RAYS_PER_BUCKET = 3;
+constexpr int FOG_HEADINGS        = 360 / FOG_HEADING_STEP;
+constexpr int FOG_LATTICE         = FOG_HEADINGS * FOG_RAYS_PER_BUCKET;                          // 216
+constexpr int FOG_CONE_HALF       = (int)FOG_VIEW_FOV / 2 / FOG_HEADING_STEP * FOG_RAYS_PER_BUCKET;   // 36 rays each side
+constexpr int FOG_LATTICE_WORDS   = (FOG_LATTICE + 63) / 64;
+constexpr float FOG_RAY_STEP      = 360.0f / FOG_LATTICE;   // degrees
+
+static_assert((int)FOG_VIEW_FOV / 2 % FOG_HEADING_STEP == 0, "cone edges sit on the ray lattice");
+
+struct FogViewer {
+    float    x, y, angle;        // latest pose
+    float    originX, originY;   // position the rays were cast from
+    int      cellX, cellY;       // quantised position of the latest pose
+    int      heading;            // heading bucket of the latest pose
+    int      castHeading;        // bucket the cone currently covers
+    bool     moved;              // changed cell since the last cast: full re-cast
+    int      rowMin, rowMax;     // rows with any bit set, or that had one since the last full cast
+    FogMask  mask;
+    uint8_t  cover[FOG_ROWS][FOG_COLS];      // rays (and the near circle) marking each cell
+    float    rayLength[FOG_LATTICE];         // traced length of each ray of the cone
+    uint64_t mayHit[FOG_LATTICE_WORDS];      // rays that can reach an obstacle from the origin
+};
+
+static std::vector<FogViewer> viewers;
+static FogMask  combined;
+static FogStats stats;
+
+static float rayDirX[FOG_LATTICE], rayDirY[FOG_LATTICE];   // same forward as the tank: (sin, -cos)
+static std::vector<AABB> nearObstacles;                    // scratch for castViewer
+
+static int cellOf(float v, int origin) {
+    return (int)std::floor((v - origin) / FOG_CELL);
+}
+
+static int wrapRay(int ray) {
+    return (ray % FOG_LATTICE + FOG_LATTICE) % FOG_LATTICE;
+}
+
+// True if lattice ray 'ray' is in the cone of heading bucket 'heading'
+static bool inCone(int ray, int heading) {
+    int d = wrapRay(ray - heading * FOG_RAYS_PER_BUCKET);
+    return d <= FOG_CONE_HALF || d >= FOG_LATTICE - FOG_CONE_HALF;
+}
+
+// Adds (DELTA = 1) or removes (-1) one ray / the near circle's mark on a
+// cell inside the grid; the mask bit is set while any of them covers it.
+// Adding is branch-free: whether a cell was already covered is random.
+template <int DELTA>
+static void coverCell(FogViewer& v, int col, int row) {
+    if (DELTA > 0) {
+        ++v.cover[row][col];
+        v.mask.set(col, row);
+        v.rowMin = std::min(v.rowMin, row);
+        v.rowMax = std::max(v.rowMax, row);
+    } else if (--v.cover[row][col] == 0) {
+        v.mask.reset(col, row);
+    }
+}
+
+static void markCell(FogViewer& v, int col, int row) {
+    if (col < 0 || col >= FOG_COLS || row < 0 || row >= FOG_ROWS) return;
+    coverCell<1>(v, col, row);
+}
+
+// Marks / unmarks every cell lattice ray 'ray' from the origin crosses
+// within 'length' pixels (grid DDA: one step per cell boundary instead of
+// fixed-size samples). Same inputs, same cells: a ray is removed by tracing
+// it again with DELTA = -1.
+template <int DELTA>
+static void traceRay(FogViewer& v, int ray, float length) {
+    float dirX = rayDirX[ray], dirY = rayDirY[ray];
+    float gx = (v.originX - FOG_X_MIN) / FOG_CELL;
+    float gy = (v.originY - FOG_Y_MIN) / FOG_CELL;
+    float cells = length / FOG_CELL;
+
+    int col = (int)std::floor(gx);
+    int row = (int)std::floor(gy);
+    int stepX = dirX > 0.0f ? 1 : -1;
+    int stepY = dirY > 0.0f ? 1 : -1;
+
+    // Ray distance (in cells) to the next column / row boundary, and between boundaries
+    const float FAR = 1e30f;
+    float deltaX = dirX != 0.0f ? 1.0f / std::fabs(dirX) : FAR;
+    float deltaY = dirY != 0.0f ? 1.0f / std::fabs(dirY) : FAR;
+    float nextX  = dirX != 0.0f ? (stepX > 0 ? col + 1 - gx : gx - col) * deltaX : FAR;
+    float nextY  = dirY != 0.0f ? (stepY > 0 ? row + 1 - gy : gy - row) * deltaY : FAR;
+
+    for (;;) {
+        // The grid is a rectangle: once the ray has left it, it never comes back
+        if (col < 0 || col >= FOG_COLS || row < 0 || row >= FOG_ROWS) {
+            if ((col < 0 && stepX < 0) || (col >= FOG_COLS && stepX > 0) ||
+                (row < 0 && stepY < 0) || (row >= FOG_ROWS && stepY > 0)) return;
+        } else {
+            coverCell<DELTA>(v, col, row);
+        }
+
+        if (nextX < nextY) {
+            if (nextX > cells) return;
+            col += stepX;
+            nextX += deltaX;
+        } else {
+            if (nextY > cells) return;
+            row += stepY;
+            nextY += deltaY;
+        }
+    }
+}
+
+// Casts one ray of the cone: it stops at the first obstacle (the cell of the
+// hit, i.e. the obstacle's face, stays visible). Rays no obstacle is in line
+// with skip the raycast.
+static void castRay(FogViewer& v, int ray) {
+    float length = FOG_VIEW_RANGE;
+    if ((v.mayHit[ray >> 6] >> (ray & 63)) & 1) {
+        ObstacleHit hit;
+        if (raycastObstacles(Fixed::fromFloat(v.originX), Fixed::fromFloat(v.originY),
+                             Fixed::fromFloat(v.originX + rayDirX[ray] * length),
+                             Fixed::fromFloat(v.originY + rayDirY[ray] * length), hit)) {
+            length *= hit.t.toFloat();
+        }
+    }
+    v.rayLength[ray] = length;
+    traceRay<1>(v, ray, length);
+}
+
+// Lattice rays that can reach an obstacle within view range: those inside
+// the angle each nearby obstacle covers, one ray of margin either side
+static void findMayHit(FogViewer& v) {
+    std::memset(v.mayHit, 0, sizeof(v.mayHit));
+
+    const float reach = FOG_VIEW_RANGE + 1.0f;
+    AABB range = {Fixed::fromFloat(v.originX - reach), Fixed::fromFloat(v.originY - reach),
+                  Fixed::fromFloat(v.originX + reach), Fixed::fromFloat(v.originY + reach)};
+    nearObstacles.clear();
+    queryObstacles(range, nearObstacles);
+
+    for (const AABB& box : nearObstacles) {
+        float minX = box.minX.toFloat() - 1.0f, minY = box.minY.toFloat() - 1.0f;
+        float maxX = box.maxX.toFloat() + 1.0f, maxY = box.maxY.toFloat() + 1.0f;
+        if (v.originX >= minX && v.originX <= maxX && v.originY >= minY && v.originY <= maxY) {
+            std::memset(v.mayHit, 0xff, sizeof(v.mayHit));   // inside: every ray stops at once
+            return;
+        }
+
+        // Spread of the corners around the direction to the centre (< 180 degrees)
+        auto angleTo = [&](float x, float y) {
+            return std::atan2(x - v.originX, v.originY - y) * 180.0f / (float)M_PI;
+        };
+        float centre = angleTo((minX + maxX) * 0.5f, (minY + maxY) * 0.5f);
+        float lo = 0.0f, hi = 0.0f;
+        const float corners[4][2] = {{minX, minY}, {maxX, minY}, {maxX, maxY}, {minX, maxY}};
+        for (const auto& c : corners) {
+            float d = std::remainder(angleTo(c[0], c[1]) - centre, 360.0f);
+            lo = std::min(lo, d);
+            hi = std::max(hi, d);
+        }
+
+        int first = (int)std::floor((centre + lo) / FOG_RAY_STEP) - 1;
+        int last  = (int)std::ceil((centre + hi) / FOG_RAY_STEP) + 1;
+        for (int ray = first; ray <= last; ++ray) {
+            int r = wrapRay(ray);
+            v.mayHit[r >> 6] |= uint64_t(1) << (r & 63);
+        }
+    }
+}
+
+// Full line-of-sight cast for one viewer (it changed cell)
+static void castViewer(FogViewer& v) {
+    std::memset(&v.mask, 0, sizeof(v.mask));
+    std::memset(v.cover, 0, sizeof(v.cover));
+    v.rowMin  = FOG_ROWS;
+    v.rowMax  = -1;
+    v.originX = v.x;
+    v.originY = v.y;
+    findMayHit(v);
+
+    // All-round awareness: cells whose centre is within FOG_NEAR_RANGE
+    int reach = (int)(FOG_NEAR_RANGE / FOG_CELL) + 1;
+    for (int row = v.cellY - reach; row <= v.cellY + reach; ++row) {
+        for (int col = v.cellX - reach; col <= v.cellX + reach; ++col) {
+            float dx = FOG_X_MIN + (col + 0.5f) * FOG_CELL - v.x;
+            float dy = FOG_Y_MIN + (row + 0.5f) * FOG_CELL - v.y;
+            if (dx * dx + dy * dy <= FOG_NEAR_RANGE * FOG_NEAR_RANGE) markCell(v, col, row);
+        }
+    }
+
+    // View cone
+    int centre = v.heading * FOG_RAYS_PER_BUCKET;
+    for (int k = -FOG_CONE_HALF; k <= FOG_CONE_HALF; ++k) castRay(v, wrapRay(centre + k));
+    v.castHeading = v.heading;
+}
+
+// The viewer only turned: removes the rays that left the cone and casts the
+// ones that entered it, from the same origin
+static void turnViewer(FogViewer& v) {
+    int oldCentre = v.castHeading * FOG_RAYS_PER_BUCKET;
+    int newCentre = v.heading * FOG_RAYS_PER_BUCKET;
+    for (int k = -FOG_CONE_HALF; k <= FOG_CONE_HALF; ++k) {
+        int ray = wrapRay(oldCentre + k);
+        if (!inCone(ray, v.heading)) traceRay<-1>(v, ray, v.rayLength[ray]);
+    }
+    for (int k = -FOG_CONE_HALF; k <= FOG_CONE_HALF; ++k) {
+        int ray = wrapRay(newCentre + k);
+        if (!inCone(ray, v.castHeading)) castRay(v, ray);
+    }
+    v.castHeading = v.heading;
+}
+
+void fogClearViewers() {
+    viewers.clear();
+    std::memset(&combined, 0, sizeof(combined));
+    stats = FogStats{};
+
+    for (int i = 0; i < FOG_LATTICE; ++i) {
+        float rad = i * FOG_RAY_STEP * (float)M_PI / 180.0f;
+        rayDirX[i] = std::sin(rad);
+        rayDirY[i] = -std::cos(rad);
+    }
+}
+
+int fogAddViewer() {
+    FogViewer v = {};
+    v.moved  = true;
+    v.rowMin = FOG_ROWS;
+    v.rowMax = -1;
+    viewers.push_back(v);
+    stats.viewers = (int)viewers.size();
+    return (int)viewers.size() - 1;
+}
+
+void fogMoveViewer(int id, float x, float y, float angleDegrees) {
+    FogViewer& v = viewers[id];
+    v.x = x;
+    v.y = y;
+    v.angle = angleDegrees;
+
+    int cellX   = cellOf(x, FOG_X_MIN);
+    int cellY   = cellOf(y, FOG_Y_MIN);
+    int heading = (int)std::lround(angleDegrees / FOG_HEADING_STEP) % FOG_HEADINGS;
+    if (heading < 0) heading += FOG_HEADINGS;
+
+    if (cellX != v.cellX || cellY != v.cellY) {
+        v.cellX = cellX;
+        v.cellY = cellY;
+        v.moved = true;
+    }
+    v.heading = heading;
+}
+
+void fogUpdate() {
+    PROFILE_SCOPE("fogUpdate");
+
+    // Rows whose combined bits may change: old and new extent of every changed viewer
+    int dirtyMin = FOG_ROWS, dirtyMax = -1;
+    stats.recast = 0;
+    stats.turned = 0;
+    for (FogViewer& v : viewers) {
+        if (!v.moved && v.heading == v.castHeading) continue;
+        dirtyMin = std::min(dirtyMin, v.rowMin);
+        dirtyMax = std::max(dirtyMax, v.rowMax);
+        if (v.moved) {
+            castViewer(v);
+            v.moved = false;
+            ++stats.recast;
+        } else {
+            turnViewer(v);
+            ++stats.turned;
+        }
+        dirtyMin = std::min(dirtyMin, v.rowMin);
+        dirtyMax = std::max(dirtyMax, v.rowMax);
+    }
+
+    for (int row = dirtyMin; row <= dirtyMax; ++row) {
+        uint64_t bits = 0;
+        for (const FogViewer& v : viewers) {
+            if (row >= v.rowMin && row <= v.rowMax) bits |= v.mask.rows[row];
+        }
+        combined.rows[row] = bits;
+    }
+    stats.rowsMerged = std::max(0, dirtyMax - dirtyMin + 1);
+}
+
+// =====================================================
+// Queries
+// =====================================================
+
+bool fogMaskSees(const FogMask& mask, float x, float y) {
+    int col = cellOf(x, FOG_X_MIN);
+    int row = cellOf(y, FOG_Y_MIN);
+    if (col < 0 || col >= FOG_COLS || row < 0 || row >= FOG_ROWS) return false;
+    return mask.test(col, row);
+}
+
+bool fogViewerSees(int id, float x, float y) {
+    return fogMaskSees(viewers[id].mask, x, y);
+}
+
+bool fogVisible(float x, float y) {
+    return fogMaskSees(combined, x, y);
+}
+
+const FogMask& fogCombinedMask() {
+    return combined;
+}
+
+const FogStats& fogStats() {
+    return stats;
+}
+
+// =====================================================
+// Rendering (GLUT thread)
+// =====================================================
+
+// Power-of-two texture (GL 1.x), the grid uses its lower-left FOG_COLS x FOG_ROWS
+constexpr int     FOG_TEX_SIZE = 64;
+constexpr GLubyte FOG_ALPHA    = 170;   // darkness of unseen cells
+
+static GLuint  fogTexture = 0;
+static FogMask uploaded;                       // mask currently in the texture
+static GLubyte texels[FOG_ROWS][FOG_COLS];     // staging for changed rows
+
+static void createFogTexture() {
+    static GLubyte allFog[FOG_TEX_SIZE * FOG_TEX_SIZE];
+    std::memset(allFog, FOG_ALPHA, sizeof(allFog));
+
+    glGenTextures(1, &fogTexture);
+    gsBindTexture2D(fogTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);   // soft cell edges
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    gsPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, FOG_TEX_SIZE, FOG_TEX_SIZE, 0,
+                 GL_ALPHA, GL_UNSIGNED_BYTE, allFog);
+
+    std::memset(&uploaded, 0, sizeof(uploaded));   // matches the all-fog texture
+}
+
+void drawFog(const FogMask& mask, const GLfloat transform[16]) {
+    PROFILE_SCOPE("drawFog");
+
+    if (!fogTexture) createFogTexture();
+    else             gsBindTexture2D(fogTexture);
+
+    // Upload the span of rows that differ from the texture in one call
+    int first = -1, last = -1;
+    for (int row = 0; row < FOG_ROWS; ++row) {
+        if (mask.rows[row] == uploaded.rows[row]) continue;
+        if (first < 0) first = row;
+        last = row;
+    }
+    if (first >= 0) {
+        for (int row = first; row <= last; ++row) {
+            for (int col = 0; col < FOG_COLS; ++col) {
+                texels[row][col] = mask.test(col, row) ? 0 : FOG_ALPHA;
+            }
+            uploaded.rows[row] = mask.rows[row];
+        }
+        gsPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, FOG_COLS, last - first + 1,
+                        GL_ALPHA, GL_UNSIGNED_BYTE, texels[first]);
+    }
+
+    // One quad over the grid, in the same space as the world layer
+    const float s = (float)FOG_COLS / FOG_TEX_SIZE;
+    const float t = (float)FOG_ROWS / FOG_TEX_SIZE;
+    const float x0 = FOG_X_MIN, x1 = FOG_X_MIN + FOG_COLS * FOG_CELL;
+    const float y0 = FOG_Y_MIN, y1 = FOG_Y_MIN + FOG_ROWS * FOG_CELL;
+    static const GLfloat FOG_COLOR[] = {0.02f, 0.03f, 0.06f, 1.0f};
+
+    gsMatrixMode(GL_MODELVIEW);
+    gsLoadMatrixf(transform);
+    gsEnable(GL_TEXTURE_2D);
+    gsEnable(GL_BLEND);
+    gsColor4fv(FOG_COLOR);   // alpha comes from the texture (GL_MODULATE)
+    glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(x0, y0);
+        glTexCoord2f(s,    0.0f); glVertex2f(x1, y0);
+        glTexCoord2f(s,    t);    glVertex2f(x1, y1);
+        glTexCoord2f(0.0f, t);    glVertex2f(x0, y1);
+    glEnd();
+    gsDisable(GL_TEXTURE_2D);
+    gsLoadIdentity();
+}
@@ -0,0 +1,96 @@
+// fog.h
+#ifndef FOG_H
+#define FOG_H
+
+#include <GL/gl.h>
+#include <cstdint>
+
+// Fog of war: line-of-sight visibility over a coarse battlefield grid.
+//
+// Every tank registers a viewer. A viewer sees the cells inside its view cone
+// (plus the cells right around it) up to the first obstacle along each ray.
+// Visibility is kept as a packed bitset, one 64-bit word per grid row, and is
+// updated incrementally:
+// - a viewer that moved to another cell is re-cast from its new position
+//   (cells are the grid's resolution, so moves inside a cell change nothing);
+// - a viewer that only turned keeps its rays: rays lie on a fixed lattice of
+//   directions, and only those that left the cone are removed and those that
+//   entered it cast (a per-cell count of covering rays keeps the mask exact);
+// - rays that no nearby obstacle is in line with skip the raycast;
+// - only the rows a changed viewer touched before or after are merged again
+//   into the combined mask.
+//
+// Sim side (fogMoveViewer / fogUpdate / queries) runs on the sim thread; the
+// combined mask is copied into WorldSnapshot and drawn by drawFog() on the
+// GLUT thread.
+
+// ---- Grid (covers the track area, must match game.cpp / graphics.cpp) ----
+
+constexpr int FOG_CELL  = 10;    // pixels per cell
+constexpr int FOG_X_MIN = 120;
+constexpr int FOG_Y_MIN = 120;
+constexpr int FOG_COLS  = 56;    // 560 px, fits one 64-bit row word
+constexpr int FOG_ROWS  = 36;    // 360 px
+
+// One bit per cell, bit c of rows[r] is cell (c, r)
+struct FogMask {
+    uint64_t rows[FOG_ROWS];
+
+    bool test(int col, int row) const { return (rows[row] >> col) & 1u; }
+    void set(int col, int row)        { rows[row] |= uint64_t(1) << col; }
+    void reset(int col, int row)      { rows[row] &= ~(uint64_t(1) << col); }
+};
+
+// ---- View parameters ----
+
+constexpr float FOG_VIEW_RANGE = 220.0f;   // pixels
+constexpr float FOG_VIEW_FOV   = 120.0f;   // degrees, centred on the barrel
+constexpr float FOG_NEAR_RANGE = 30.0f;    // all-round awareness radius
+constexpr int   FOG_HEADING_STEP = 5;      // degrees per heading bucket (= rotation step)
+
+struct FogStats {
+    int viewers;
+    int recast;       // viewers fully re-cast by the last fogUpdate() (changed cell)
+    int turned;       // viewers that only turned: just the cone's edges re-cast
+    int rowsMerged;   // combined-mask rows rebuilt by the last fogUpdate()
+};
+
+// --- Viewers (Defined in fog.cpp, sim thread) ---
+
+void fogClearViewers();
+
+// Returns the new viewer's id (ids are dense, starting at 0)
+int fogAddViewer();
+
+// Records the viewer's pose; the next fogUpdate() re-casts it if its cell
+// changed, or updates the edges of its cone if only its heading bucket did
+void fogMoveViewer(int id, float x, float y, float angleDegrees);
+
+// Re-casts moved / turned viewers and rebuilds the affected rows of the combined mask
+void fogUpdate();
+
+// --- Queries (perception / interest management) ---
+
+// True if world point (x, y) is visible to this viewer
+bool fogViewerSees(int id, float x, float y);
+
+// True if (x, y) is visible to any viewer
+bool fogVisible(float x, float y);
+
+// True if (x, y) is set in 'mask' (e.g. the snapshot copy, on the GLUT thread)
+bool fogMaskSees(const FogMask& mask, float x, float y);
+
+// Union of every viewer's visibility
+const FogMask& fogCombinedMask();
+
+const FogStats& fogStats();
+
+// --- Rendering (GLUT thread) ---
+
+// Darkens the cells not set in 'mask'. The mask lives in a texture; only the
+// rows that changed since the previous call are uploaded, in one
+// glTexSubImage2D. 'transform' is the column-major matrix the world layer was
+// recorded with (reflection / shear effects).
+void drawFog(const FogMask& mask, const GLfloat transform[16]);
+
+#endif // FOG_H
@@ -2,14 +2,33 @@
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdio>   // for sprintf
-#include <cstdlib>  // for rand, srand
 #include <ctime>    // for time()
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #include "game.h"      // Car struct, WIDTH, HEIGHT
 #include "graphics.h"  // drawBackground, drawTrack, drawScenery, drawCarBody
+#include "render.h"    // render command recording + submission
+#include "glstate.h"   // GL state cache (per-frame call savings)
+#include "simthread.h" // input queue, stopSimThread
+#include "obstacles.h" // static level geometry (BVH)
+#include "fog.h"       // line-of-sight visibility
+#include "events.h"    // gameEvents bus
+#include "telemetry.h" // telemetryRecordTick, telemetryClose
+#include "dynres.h"    // dynamic resolution (scaled world, native HUD)
+#include "scheduler.h" // tick scheduler (round timer, waves)
+#include "transform.h" // tank part hierarchy
+#include "terrain.h"   // craters: ground material + decals
+#include "swept.h"     // continuous bullet collision
+#include "spawn.h"     // Poisson-disk target placement
+#include "splitscreen.h" // split-screen viewports and cameras
+#include "profiler.h"  // PROFILE_SCOPE, overlay (must stay last: hooks GL calls)
 
 // ---- Global game state ----
-Car player;
+Car  players[MAX_PLAYERS];
+Car& player = players[0];
+static int localPlayers = 1;   // see setPlayerCount
 
 // Transform toggles (for your 2D transformations requirement)
 bool reflectScene = false;
@@ -21,6 +40,29 @@ int score = 0;
 // Timer & game over flag
 int  timeLeft = 60;   // seconds of gameplay
 bool gameOver = false;
+static int roundSeconds = 60;   // see setRoundSeconds
+
+// Fog of war (V key): hides what the players' tanks cannot see
+static bool fogOfWar = false;
+
+// Simulation ticks since start
+static unsigned long long simTick = 0;
+
+// Base ticks simulated per updateGame() (fast-forward, see setSimStepTicks)
+static int simStepTicks = 1;
+
+// Sim phase timing for stress runs (nullptr = off, see setSimPhaseTimes)
+static double* phaseNs = nullptr;
+static std::chrono::steady_clock::time_point phaseStart;
+
+// Waves spawned this round; targets of the current wave still standing
+static int wave = 0;
+static int targetsAlive = 0;
+static SimSignal targetsCleared;   // raised by the hit that clears a wave
+
+// Target placement: own random stream (seedSpawns) and reused spot buffer
+static Rng                     spawnRng = rngSeed(0, RNG_STREAM_SPAWN);
+static std::vector<SpawnPoint> spawnPoints;
 
 // Define PI for calculations
 #ifndef M_PI
@@ -38,161 +80,374 @@ static constexpr int INNER_Y_MIN  = TRACK_Y_MIN + CURB_OFFSET; // 140
 static constexpr int INNER_X_MAX  = TRACK_X_MAX - CURB_OFFSET; // 660
 static constexpr int INNER_Y_MAX  = TRACK_Y_MAX - CURB_OFFSET; // 460
 
+// Inside the inner track boundaries; bullets come down when they leave it
+static constexpr AABB BATTLEFIELD = {Fixed::fromInt(INNER_X_MIN), Fixed::fromInt(INNER_Y_MIN),
+                                     Fixed::fromInt(INNER_X_MAX), Fixed::fromInt(INNER_Y_MAX)};
+
+// Collision box half size of a tank (hull is ~44 x 52 at 0.9 scale)
+static constexpr Fixed TANK_HALF_SIZE = Fixed::fromInt(18);
+
+// Gap kept between a tank and an obstacle after a sweep, so the next sweep
+// starts outside it (also after the position is stored as a FieldCoord)
+static constexpr Fixed CONTACT_SKIN = Fixed::fromFloat(0.01f);
+static_assert(CONTACT_SKIN > FIELD_ROUNDING, "storing a tank must not round it into an obstacle");
+
+// Tuning (sim units: px and px per tick)
+static constexpr Fixed  TANK_ACCEL     = Fixed::fromFloat(0.2f);
+static constexpr Fixed  TANK_MAX_SPEED = Fixed::fromInt(5);
+static constexpr Fixed  TANK_MIN_SPEED = Fixed::fromInt(-2);
+static constexpr BAngle TANK_TURN_STEP = bangleFromDegrees(5.0f);
+static constexpr BAngle TURRET_STEP    = bangleFromDegrees(5.0f);
+static constexpr Fixed  BULLET_SPEED   = Fixed::fromInt(8);
+static constexpr Fixed  BULLET_RADIUS  = Fixed::fromInt(4);
+static constexpr Fixed  TARGET_RADIUS  = Fixed::fromInt(15);
+
+// ---- Tank part layout (must match drawTankHull/Turret/Barrel in graphics.cpp) ----
+static constexpr Fixed TANK_DRAW_SCALE = Fixed::fromFloat(0.9f);   // hull model -> world
+static constexpr Fixed BARREL_ROOT_Y   = Fixed::fromInt(-24);      // in turret space
+static constexpr Fixed MUZZLE_Y        = Fixed::fromInt(-19);      // in barrel space
+
+// World matrices of every tank's parts (see TankPart); rebuilt with the tanks
+static TransformGraph tankParts;
+
+// ---- Key maps ----
+
+// Gameplay keys of each local player, applied on the sim thread. Special
+// keys (arrows, Home ...) are KEY_SPECIAL + GLUT_KEY_*; ASCII keys as is
+static constexpr int KEY_SPECIAL = 0x100;
+
+struct KeyMap {
+    int forward, back;           // accelerate / brake, reverse
+    int left, right;             // rotate the hull
+    int turretLeft, turretRight;
+    int fire;
+    int stop;
+    const char* label;           // split-screen viewport caption, same order
+};
+
+static const KeyMap KEY_MAPS[MAX_PLAYERS] = {
+    {'w', 's', KEY_SPECIAL + GLUT_KEY_LEFT, KEY_SPECIAL + GLUT_KEY_RIGHT, 'q', 'e', ' ', 'f',
+     "P1  W/S  Left/Right  Q/E  Space  F"},
+    {'i', 'k', 'j', 'l', 'u', 'o', '\r', 'm',
+     "P2  I/K  J/L  U/O  Enter  M"},
+    {'8', '5', '4', '6', '7', '9', '0', '.',   // numeric keypad, Num Lock on
+     "P3  Num 8/5  4/6  7/9  0  ."},
+    {KEY_SPECIAL + GLUT_KEY_HOME, KEY_SPECIAL + GLUT_KEY_END, 127 /* Delete */, KEY_SPECIAL + GLUT_KEY_PAGE_DOWN,
+     KEY_SPECIAL + GLUT_KEY_INSERT, KEY_SPECIAL + GLUT_KEY_PAGE_UP, KEY_SPECIAL + GLUT_KEY_UP, KEY_SPECIAL + GLUT_KEY_DOWN,
+     "P4  Home/End  Del/PgDn  Ins/PgUp  Up  Down"},
+};
+
 // =====================================================
 // Bullets & Targets
 // =====================================================
 
-struct Bullet {
-    float x, y;
-    float vx, vy;
-    bool  active;
+std::vector<Bullet> bullets(MAX_BULLETS);
+std::vector<Target> targets(NUM_TARGETS);
+ActiveBits          bulletActive = ActiveBits::withSlots(MAX_BULLETS);
+ActiveBits          targetActive = ActiveBits::withSlots(NUM_TARGETS);
+std::vector<Car>    bots;
+
+// The move a bullet makes this tick, from (x0, y0), cut short at an
+// obstacle / the battlefield edge ('stops'). Kept unrounded, so the target
+// sweep follows the exact path.
+struct BulletPath {
+    Fixed x0, y0;
+    Fixed dx, dy;
+    bool  stops;
 };
 
-struct Target {
-    float x, y;
-    float radius;
-    bool  active;
+// A bullet's earliest target along its path this tick. Hits are settled in
+// order of impact (then bullet index), not of bullet slot, so which bullet
+// takes a target does not depend on the pool layout or on --step. Only
+// bullets that reach a target get one, so the pool carries no per-slot path.
+struct TargetHit {
+    Fixed      at;       // fraction of the path
+    int        bullet;
+    int        target;
+    BulletPath path;
 };
+static std::vector<TargetHit> targetHits;   // min-heap on (at, bullet), reused every tick
+
+static bool hitsLater(const TargetHit& a, const TargetHit& b) {
+    return a.at != b.at ? a.at > b.at : a.bullet > b.bullet;
+}
 
-constexpr int MAX_BULLETS = 20;
-constexpr int NUM_TARGETS = 5;
+// Broad phase for the target sweeps: targets bucketed by the grid cell of
+// their centre, so a move only sweeps against the targets in the cells its
+// box (grown by the hit radius) covers. The grid spans the whole FieldCoord
+// range, and each cell lists its targets in ascending order. Rebuilt after
+// targets are placed; targets hit since stay listed and are skipped by
+// their active bit.
+static constexpr int TARGET_CELL_SHIFT = 5;   // 32 px cells
+static constexpr int TARGET_GRID       = (1 << (16 - FieldCoord::FRAC_BITS)) >> TARGET_CELL_SHIFT;
+
+static std::vector<int> targetCellStart(TARGET_GRID * TARGET_GRID + 1);   // cell c is [start[c], start[c + 1])
+static std::vector<int> targetCellList;                                   // capacity only grows
+static std::vector<int> targetCellNext(TARGET_GRID * TARGET_GRID);        // fill position per cell (rebuild only)
+static bool             targetGridDirty = true;
+
+// Velocity of a bullet in px per tick (forward is (sin, -cos) as for tanks)
+static void bulletVelocity(const Bullet& b, Fixed& vx, Fixed& vy) {
+    vx = fxSin(b.heading) * BULLET_SPEED;
+    vy = -(fxCos(b.heading) * BULLET_SPEED);
+}
+
+// Pools are only resized here, never during a frame
+void setEntityCounts(int bulletSlots, int targetCount) {
+    bullets.assign(bulletSlots, Bullet{});
+    targets.assign(targetCount, Target{});
+    bulletActive.resize(bulletSlots);
+    targetActive.resize(targetCount);
+    targetGridDirty = true;
+}
 
-Bullet bullets[MAX_BULLETS];
-Target targets[NUM_TARGETS];
+void setPlayerCount(int count) {
+    localPlayers = std::clamp(count, 1, MAX_PLAYERS);
+}
+
+int playerCount() {
+    return localPlayers;
+}
+
+void setBotCount(int count) {
+    bots.assign(count, Car{});
+}
+
+void setRoundSeconds(int seconds) {
+    roundSeconds = seconds;
+}
+
+void setSimPhaseTimes(double* ns) {
+    phaseNs = ns;
+}
+
+void setSimStepTicks(int ticks) {
+    simStepTicks = std::max(1, ticks);
+}
 
 // =====================================================
 // Helpers
 // =====================================================
 
-// Random float in [a, b]
-static float randFloat(float a, float b) {
-    return a + (b - a) * (std::rand() / (float)RAND_MAX);
+// Event stamped with the current tick; the caller fills in the payload
+static GameEvent makeEvent(GameEventType type) {
+    GameEvent e = {};
+    e.tick = simTick;
+    e.type = type;
+    return e;
 }
 
-// Apply reflection and shear transformations to the whole scene
-static void applyTransformEffects() {
-    // Reflection across horizontal axis around center of window
+// Closes the running sim phase: adds its time to phaseNs[phase] and starts the next
+static void endPhase(SimPhase phase) {
+    if (!phaseNs) return;
+    auto now = std::chrono::steady_clock::now();
+    phaseNs[phase] += std::chrono::duration<double, std::nano>(now - phaseStart).count();
+    phaseStart = now;
+}
+
+// Player starts: spread evenly along the bottom of the track (a single
+// player in the middle)
+static Car playerStart(int index, float degrees) {
+    int x = INNER_X_MIN + (index + 1) * (INNER_X_MAX - INNER_X_MIN) / (localPlayers + 1);
+    return {FieldCoord::fromFixed(Fixed::fromInt(x)), FieldCoord::fromFixed(Fixed::fromInt(INNER_Y_MIN + 50)),
+            bangleFromDegrees(degrees), 0, PackedSpeed{0}};
+}
+
+// Tanks 0 .. localPlayers - 1 are the players, then the bots
+static const Car& tankAt(int tank) {
+    return tank < localPlayers ? players[tank] : bots[tank - localPlayers];
+}
+
+static int tankCount() {
+    return localPlayers + (int)bots.size();
+}
+
+// Copies the poses of tanks [first, last) into their part nodes and
+// recomputes the matrices that changed
+static void syncTankParts(int first, int last) {
+    const Fixed zero = Fixed::fromInt(0);
+    for (int i = first; i < last; ++i) {
+        const Car& tank = tankAt(i);
+        int        hull = i * TANK_PART_COUNT + TANK_HULL;
+        tfSetLocal(tankParts, hull, tank.x.toFixed(), tank.y.toFixed(), tank.angle);
+        tfSetLocal(tankParts, hull + TANK_TURRET, zero, zero, tank.turret);
+    }
+    tfUpdate(tankParts, first * TANK_PART_COUNT, last * TANK_PART_COUNT);
+}
+
+// One hull -> turret -> barrel chain per tank (after the tanks are placed)
+static void buildTankParts() {
+    const Fixed zero = Fixed::fromInt(0);
+    const Fixed one  = Fixed::fromInt(1);
+
+    tfClear(tankParts);
+    for (int i = 0; i < tankCount(); ++i) {
+        int hull   = tfAdd(tankParts, -1, zero, zero, 0, TANK_DRAW_SCALE);
+        int turret = tfAdd(tankParts, hull, zero, zero, 0, one);
+        tfAdd(tankParts, turret, zero, BARREL_ROOT_Y, 0, one);
+    }
+    syncTankParts(0, tankCount());
+}
+
+// Reflection / shear as one matrix (column-major), shared by the recorded
+// world layer and the fog overlay
+static void transformEffectsMatrix(GLfloat m[16]) {
+    for (int i = 0; i < 16; ++i) m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+
+    // Reflection across horizontal axis around center of window: y' = HEIGHT - y
     if (reflectScene) {
-        glTranslatef(0.0f, HEIGHT / 2.0f, 0.0f);
-        glScalef(1.0f, -1.0f, 1.0f);   // reflect in Y
-        glTranslatef(0.0f, -HEIGHT / 2.0f, 0.0f);
+        m[5]  = -1.0f;
+        m[13] = (float)HEIGHT;
     }
 
-    // Shear along X-axis (for a drifting/skew effect)
+    // Shear along X-axis (for a drifting/skew effect), applied before the reflection
     if (shearEffect) {
-        float shx = 0.3f;
-        GLfloat m[16] = {
-            1.0f, 0.0f, 0.0f, 0.0f,
-            shx,  1.0f, 0.0f, 0.0f,
-            0.0f, 0.0f, 1.0f, 0.0f,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-        glMultMatrixf(m);
+        m[4] = 0.3f;
     }
 }
 
-// Draw the player tank using the car/tank's position and angle
-static void drawPlayerTank() {
-    glPushMatrix();
-
-    // Position the tank in world space
-    glTranslatef(player.x, player.y, 0.0f);
+// Apply reflection and shear transformations to the whole scene
+static void applyTransformEffects() {
+    GLfloat m[16];
+    transformEffectsMatrix(m);
+    rcMultMatrixf(m);
+}
 
-    // Rotate around its center
-    glRotatef(player.angle, 0.0f, 0.0f, 1.0f);
+// Draw a tank from the world matrices of its parts (hull, turret, barrel),
+// computed on the sim side; no per-frame transform math here
+static void drawTank(const Affine2 parts[TANK_PART_COUNT]) {
+    PROFILE_SCOPE("drawTank");
 
-    // Slightly scale (optional)
-    glScalef(0.9f, 0.9f, 1.0f);
+    static void (*const drawPart[TANK_PART_COUNT])() = {drawTankHull, drawTankTurret, drawTankBarrel};
 
-    // This uses your tank drawing from graphics.cpp (drawCarBody now = tank)
-    drawCarBody();
+    for (int p = 0; p < TANK_PART_COUNT; ++p) {
+        GLfloat m[16];
+        tfToGlMatrix(parts[p], m);
 
-    glPopMatrix();
+        rcPushMatrix();
+        rcMultMatrixf(m);
+        drawPart[p]();
+        rcPopMatrix();
+    }
 }
 
 // Draw bullets as small yellow squares
-static void drawBullets() {
-    glBegin(GL_QUADS);
-    for (int i = 0; i < MAX_BULLETS; ++i) {
-        if (!bullets[i].active) continue;
+static void drawBullets(const std::vector<Bullet>& bullets, const ActiveBits& active) {
+    PROFILE_SCOPE("drawBullets");
 
+    rcBegin(GL_QUADS);
+    active.forEach([&](int i) {
         float size = 4.0f;
-        glColor3f(1.0f, 1.0f, 0.0f); // yellow bullet
-
-        glVertex2f(bullets[i].x - size, bullets[i].y - size);
-        glVertex2f(bullets[i].x + size, bullets[i].y - size);
-        glVertex2f(bullets[i].x + size, bullets[i].y + size);
-        glVertex2f(bullets[i].x - size, bullets[i].y + size);
-    }
-    glEnd();
+        float x = bullets[i].x.toFloat();
+        float y = bullets[i].y.toFloat();
+        rcColor3f(1.0f, 1.0f, 0.0f); // yellow bullet
+
+        rcVertex2f(x - size, y - size);
+        rcVertex2f(x + size, y - size);
+        rcVertex2f(x + size, y + size);
+        rcVertex2f(x - size, y + size);
+    });
+    rcEnd();
 }
 
 // Draw targets as red circles with black outline
-static void drawTargets() {
-    for (int i = 0; i < NUM_TARGETS; ++i) {
-        if (!targets[i].active) continue;
+static void drawTargets(const std::vector<Target>& targets, const ActiveBits& active) {
+    PROFILE_SCOPE("drawTargets");
 
-        float cx = targets[i].x;
-        float cy = targets[i].y;
-        float r  = targets[i].radius;
+    const float r = TARGET_RADIUS.toFloat();
+    active.forEach([&](int i) {
+        float cx = targets[i].x.toFloat();
+        float cy = targets[i].y.toFloat();
 
         // Filled circle (simple triangle fan)
-        glColor3f(0.8f, 0.1f, 0.1f); // red
-        glBegin(GL_TRIANGLE_FAN);
-            glVertex2f(cx, cy);
+        rcColor3f(0.8f, 0.1f, 0.1f); // red
+        rcBegin(GL_TRIANGLE_FAN);
+            rcVertex2f(cx, cy);
             for (int a = 0; a <= 360; ++a) {
                 float rad = a * (float)M_PI / 180.0f;
-                glVertex2f(cx + std::cos(rad) * r,
+                rcVertex2f(cx + std::cos(rad) * r,
                            cy + std::sin(rad) * r);
             }
-        glEnd();
+        rcEnd();
 
         // Outline
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glBegin(GL_LINE_LOOP);
+        rcColor3f(0.0f, 0.0f, 0.0f);
+        rcBegin(GL_LINE_LOOP);
             for (int a = 0; a < 360; ++a) {
                 float rad = a * (float)M_PI / 180.0f;
-                glVertex2f(cx + std::cos(rad) * r,
+                rcVertex2f(cx + std::cos(rad) * r,
                            cy + std::sin(rad) * r);
             }
-        glEnd();
-    }
+        rcEnd();
+    });
 }
 
 // Simple text drawing helper for HUD
 static void drawText(float x, float y, const char* text) {
-    glRasterPos2f(x, y);
-    while (*text) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *text);
-        ++text;
+    rcText(x, y, GLUT_BITMAP_HELVETICA_18, text);
+}
+
+// Split-screen: frame around each viewport and its player's keys (same
+// order as the controls line) in the bottom left corner
+static void drawViewCaptions(const SplitView views[], int viewCount) {
+    rcLineWidth(2.0f);
+    for (int v = 0; v < viewCount; ++v) {
+        const SplitView& view = views[v];
+        float x0 = view.x * WIDTH, x1 = (view.x + view.w) * WIDTH;
+        float y0 = view.y * HEIGHT, y1 = (view.y + view.h) * HEIGHT;
+
+        rcColor3f(0.0f, 0.0f, 0.0f);
+        rcBegin(GL_LINE_LOOP);
+            rcVertex2f(x0, y0);
+            rcVertex2f(x1, y0);
+            rcVertex2f(x1, y1);
+            rcVertex2f(x0, y1);
+        rcEnd();
+
+        rcColor3f(1.0f, 1.0f, 1.0f);
+        rcText(x0 + 8.0f, y0 + 8.0f, GLUT_BITMAP_8_BY_13,
+               view.player >= 0 ? KEY_MAPS[view.player].label : "Battlefield");
     }
+    rcLineWidth(1.0f);
 }
 
 // Draw a small HUD: controls + score + timer + GAME OVER
-static void drawHUD() {
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+static void drawHUD(const WorldSnapshot& world, const SplitView views[], int viewCount) {
+    PROFILE_SCOPE("drawHUD");
 
-    // Controls info (top-left)
-    glColor3f(1.0f, 1.0f, 1.0f);
+    rcLayer(LAYER_HUD);
+    rcLoadIdentity();
+
+    if (viewCount > 1) drawViewCaptions(views, viewCount);
+
+    // Controls info (top-left): driving, then toggles (all keys in README)
+    rcColor3f(1.0f, 1.0f, 1.0f);
     drawText(10.0f, HEIGHT - 20.0f,
-             "W/S: move  |  Left/Right: rotate  |  SPACE: fire  |  R: reflect  |  H: shear  |  N: restart  |  F: stop car");
+             "W/S: move  |  Left/Right: rotate  |  Q/E: turret  |  SPACE: fire  |  F: stop car");
+    drawText(10.0f, HEIGHT - 40.0f,
+             "V: fog  |  G: dynres  |  R: reflect  |  H: shear  |  N: restart");
 
     // Score (top-left)
     char buffer[64];
-    std::sprintf(buffer, "Score: %d", score);
-    drawText(10.0f, HEIGHT - 40.0f, buffer);
+    std::sprintf(buffer, "Score: %d", world.score);
+    drawText(10.0f, HEIGHT - 60.0f, buffer);
 
     // Time left (top-left)
-    std::sprintf(buffer, "Time: %d", timeLeft);
-    drawText(10.0f, HEIGHT - 60.0f, buffer);
+    std::sprintf(buffer, "Time: %d", world.timeLeft);
+    drawText(10.0f, HEIGHT - 80.0f, buffer);
+
+    // Internal resolution, while dynamic scaling has lowered it
+    if (dynresScale() < 1.0f) {
+        std::sprintf(buffer, "Render scale: %d%%", (int)(dynresScale() * 100.0f + 0.5f));
+        drawText(10.0f, HEIGHT - 100.0f, buffer);
+    }
 
     // If game over, show big message in center (WHITE)
-    if (gameOver) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+    if (world.gameOver) {
+        rcColor3f(1.0f, 1.0f, 1.0f);
         drawText(WIDTH / 2.0f - 60.0f, HEIGHT / 2.0f + 10.0f, "GAME OVER");
 
-        std::sprintf(buffer, "Final Score: %d", score);
+        std::sprintf(buffer, "Final Score: %d", world.score);
         drawText(WIDTH / 2.0f - 80.0f, HEIGHT / 2.0f - 10.0f, buffer);
 
         drawText(WIDTH / 2.0f - 130.0f, HEIGHT / 2.0f - 30.0f,
@@ -200,238 +455,734 @@ static void drawHUD() {
     }
 }
 
-// Spawn a bullet from the tank's cannon
-static void spawnBullet() {
-    if (gameOver) return; // don't shoot after time is over
+// =====================================================
+// Event effects (GLUT thread, consumes gameEvents)
+// =====================================================
+
+constexpr int MAX_EFFECTS       = 32;
+constexpr int MUZZLE_FLASH_TICKS = 4;
+constexpr int HIT_MARKER_TICKS  = 30;
+constexpr int WAVE_BANNER_TICKS = 2 * TICKS_PER_SECOND;
+
+struct Effect {
+    GameEventType      type;   // EVENT_BULLET_FIRED or EVENT_TARGET_HIT
+    float              x, y;
+    unsigned long long tick;
+};
+
+static Effect             effects[MAX_EFFECTS];   // ring, oldest overwritten first
+static int                effectCount = 0;
+static int                bannerWave  = 0;
+static unsigned long long bannerTick  = 0;
 
-    // Find an inactive bullet slot
-    int index = -1;
-    for (int i = 0; i < MAX_BULLETS; ++i) {
-        if (!bullets[i].active) {
-            index = i;
+// Starts at the very first event, so the wave spawned by initGame() is shown
+static EventCursor effectEvents = {0, 0};
+
+static void consumeEffectEvents(const WorldSnapshot& world) {
+    GameEvent e;
+    while (gameEvents.poll(effectEvents, e)) {
+        switch (e.type) {
+        case EVENT_BULLET_FIRED:
+            effects[effectCount++ % MAX_EFFECTS] = {e.type, e.bulletFired.x, e.bulletFired.y, e.tick};
+            break;
+        case EVENT_TARGET_HIT:
+            // Hits the player cannot see stay hidden under fog of war
+            if (world.fogOfWar && !fogMaskSees(world.fog, e.targetHit.x, e.targetHit.y)) break;
+            effects[effectCount++ % MAX_EFFECTS] = {e.type, e.targetHit.x, e.targetHit.y, e.tick};
+            break;
+        case EVENT_SHELL_IMPACT:
+            terrainStampImpact(e.shellImpact.col, e.shellImpact.row);
+            break;
+        case EVENT_WAVE_SPAWNED:
+            bannerWave = e.waveSpawned.wave;
+            bannerTick = e.tick;
+            if (e.waveSpawned.wave == 1) terrainClearDecals();   // new round: fresh ground
+            break;
+        case EVENT_GAME_OVER:   // the HUD already shows the snapshot's game over state
             break;
         }
     }
+}
+
+// Ticks since 'tick' (events can be one tick ahead of the drawn snapshot)
+static int ticksSince(unsigned long long now, unsigned long long tick) {
+    return now > tick ? (int)std::min<unsigned long long>(now - tick, 1u << 20) : 0;
+}
+
+// Muzzle flashes and expanding hit rings, in world space
+static void drawEffects(unsigned long long now) {
+    PROFILE_SCOPE("drawEffects");
+
+    rcBlend(true);
+    for (int i = 0; i < std::min(effectCount, MAX_EFFECTS); ++i) {
+        const Effect& fx = effects[i];
+        int age = ticksSince(now, fx.tick);
+
+        if (fx.type == EVENT_BULLET_FIRED && age < MUZZLE_FLASH_TICKS) {
+            float fade = 1.0f - (float)age / MUZZLE_FLASH_TICKS;
+            GLfloat flash[] = {1.0f, 0.75f, 0.2f, fade};
+            rcColor4fv(flash);
+            rcBegin(GL_TRIANGLE_FAN);
+                rcVertex2f(fx.x, fx.y);
+                for (int a = 0; a <= 360; a += 45) {
+                    float r   = (a % 90 == 0) ? 9.0f : 4.0f;   // star shape
+                    float rad = a * (float)M_PI / 180.0f;
+                    rcVertex2f(fx.x + std::cos(rad) * r, fx.y + std::sin(rad) * r);
+                }
+            rcEnd();
+        } else if (fx.type == EVENT_TARGET_HIT && age < HIT_MARKER_TICKS) {
+            float k = (float)age / HIT_MARKER_TICKS;
+            GLfloat ring[] = {1.0f, 0.9f, 0.3f, 1.0f - k};
+            rcColor4fv(ring);
+            rcBegin(GL_LINE_LOOP);
+                float r = 15.0f + 25.0f * k;
+                for (int a = 0; a < 360; a += 15) {
+                    float rad = a * (float)M_PI / 180.0f;
+                    rcVertex2f(fx.x + std::cos(rad) * r, fx.y + std::sin(rad) * r);
+                }
+            rcEnd();
+            rcText(fx.x - 8.0f, fx.y + 20.0f + 20.0f * k, GLUT_BITMAP_HELVETICA_18, "+1");
+        }
+    }
+    rcBlend(false);
+}
+
+// "Wave N" banner for a couple of seconds after each wave spawns
+static void drawWaveBanner(unsigned long long now) {
+    if (bannerWave == 0 || ticksSince(now, bannerTick) >= WAVE_BANNER_TICKS) return;
+
+    char buffer[32];
+    std::sprintf(buffer, "Wave %d", bannerWave);
+    rcColor3f(1.0f, 0.9f, 0.3f);
+    drawText(WIDTH / 2.0f - 30.0f, HEIGHT - 60.0f, buffer);
+}
+
+// A shell comes down at (x, y): crater in the ground (sim), decal on the
+// GLUT thread (via the event)
+static void shellImpact(Fixed x, Fixed y) {
+    int col, row;
+    terrainCellOf(x, y, col, row);
+    terrainImpact(col, row);
+
+    GameEvent e = makeEvent(EVENT_SHELL_IMPACT);
+    e.shellImpact = {x.toFloat(), y.toFloat(), col, row};
+    gameEvents.publish(e);
+}
+
+static int targetCellOf(const Target& t) {
+    int shift = FieldCoord::FRAC_BITS + TARGET_CELL_SHIFT;
+    return (t.y.q >> shift) * TARGET_GRID + (t.x.q >> shift);
+}
+
+static int targetGridCoord(Fixed v) {
+    return std::clamp(v.raw >> (Fixed::FRAC_BITS + TARGET_CELL_SHIFT), 0, TARGET_GRID - 1);
+}
+
+// Counting sort of the active targets by cell
+static void bucketTargets() {
+    std::fill(targetCellStart.begin(), targetCellStart.end(), 0);
+    targetActive.forEach([&](int t) { targetCellStart[targetCellOf(targets[t]) + 1]++; });
+    for (int c = 0; c < TARGET_GRID * TARGET_GRID; ++c) targetCellStart[c + 1] += targetCellStart[c];
+
+    targetCellList.resize(targetCellStart.back());
+    std::copy(targetCellStart.begin(), targetCellStart.end() - 1, targetCellNext.begin());
+    targetActive.forEach([&](int t) { targetCellList[targetCellNext[targetCellOf(targets[t])]++] = t; });
+    targetGridDirty = false;
+}
+
+// Earliest active target the move p -> p + d reaches, -1 if none; 'first'
+// is the fraction of the move at which it does (ties go to the lowest index)
+static int firstTargetAlong(Fixed px, Fixed py, Fixed dx, Fixed dy, Fixed& first) {
+    const Fixed hitRadius = TARGET_RADIUS + BULLET_RADIUS;
+    if (targetGridDirty) bucketTargets();
+
+    int col0 = targetGridCoord(std::min(px, px + dx) - hitRadius);
+    int col1 = targetGridCoord(std::max(px, px + dx) + hitRadius);
+    int row0 = targetGridCoord(std::min(py, py + dy) - hitRadius);
+    int row1 = targetGridCoord(std::max(py, py + dy) + hitRadius);
+
+    first = Fixed::fromInt(1);
+    int hitTarget = -1;
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            int cell = row * TARGET_GRID + col;
+            for (int k = targetCellStart[cell]; k < targetCellStart[cell + 1]; ++k) {
+                int t = targetCellList[k];
+                if (!targetActive.test(t)) continue;
+
+                Fixed at;
+                if (sweepCircle(px, py, dx, dy, targets[t].x.toFixed(), targets[t].y.toFixed(), hitRadius, at) &&
+                    (hitTarget < 0 || at < first || (at == first && t < hitTarget))) {
+                    first     = at;
+                    hitTarget = t;
+                }
+            }
+        }
+    }
+    return hitTarget;
+}
+
+// Bullet 'bullet' (already inactive) destroys 'target' at (x, y)
+static void bulletHitsTarget(int bullet, int target, Fixed x, Fixed y) {
+    targetActive.reset(target);
+    score += 1;
+    shellImpact(x, y);
+
+    GameEvent e = makeEvent(EVENT_TARGET_HIT);
+    e.targetHit = {target, bullet, targets[target].x.toFloat(), targets[target].y.toFloat(), score};
+    gameEvents.publish(e);
+
+    if (--targetsAlive == 0) targetsCleared.notify();
+}
+
+// Spawn a bullet from the player tank's cannon
+void spawnBullet() {
+    spawnBulletFrom(0);
+}
+
+// Spawn a bullet from a tank's cannon
+void spawnBulletFrom(int tank) {
+    if (gameOver) return; // don't shoot after time is over
+
+    // Find an inactive bullet slot (64 slots per word of the bitmask)
+    int index = bulletActive.firstClear((int)bullets.size());
     if (index == -1) return; // no free bullet slot
 
-    float rad = player.angle * (float)M_PI / 180.0f;
+    // Key presses and scripts may have moved the tank since the last tick
+    syncTankParts(tank, tank + 1);
+    const TransformNode& barrel = tankParts.nodes[tank * TANK_PART_COUNT + TANK_BARREL];
+
+    // Start at the muzzle, heading along the barrel
+    Fixed x, y;
+    tfApply(barrel.world, Fixed::fromInt(0), MUZZLE_Y, x, y);
+    Bullet& b = bullets[index];
+    b = {FieldCoord::fromFixed(x), FieldCoord::fromFixed(y), barrel.worldAngle};
+
+    Fixed vx, vy;
+    bulletVelocity(b, vx, vy);
+    GameEvent e = makeEvent(EVENT_BULLET_FIRED);
+    e.bulletFired = {index, b.x.toFloat(), b.y.toFloat(), vx.toFloat(), vy.toFloat()};
+    gameEvents.publish(e);
+
+    // The muzzle sticks out past the hull: a shell fired point-blank stops
+    // at the wall or target between the tank's centre and the muzzle
+    // instead of appearing beyond it
+    const Car& shooter = tankAt(tank);
+    Fixed cx = shooter.x.toFixed(), cy = shooter.y.toFixed();
+    Fixed dx = x - cx, dy = y - cy;
+
+    Fixed wallAt = Fixed::fromInt(1);
+    ObstacleHit hit;
+    bool blocked = raycastObstacles(cx, cy, x, y, hit);
+    if (blocked) wallAt = hit.t;
+
+    Fixed targetAt;
+    int   target = firstTargetAlong(cx, cy, dx, dy, targetAt);
+    if (target >= 0 && targetAt <= wallAt) {
+        bulletHitsTarget(index, target, cx + dx * targetAt, cy + dy * targetAt);
+    } else if (blocked) {
+        shellImpact(cx + dx * wallAt, cy + dy * wallAt);
+    } else {
+        bulletActive.set(index);
+    }
+}
 
-    // Direction: same forward as tank movement (front is negative Y)
-    float dirX = std::sin(rad);
-    float dirY = -std::cos(rad);
+void seedSpawns(unsigned long long seed) {
+    spawnRng = rngSeed(seed, RNG_STREAM_SPAWN);
+}
 
-    // Start a bit in front of the tank
-    float spawnDist = 40.0f;
-    bullets[index].x = player.x + dirX * spawnDist;
-    bullets[index].y = player.y + dirY * spawnDist;
+// Reset / respawn all targets at random, non-overlapping positions
+void resetTargets() {
+    int margin = 40; // keep away from curb
+    AABB area = {Fixed::fromInt(INNER_X_MIN + margin), Fixed::fromInt(INNER_Y_MIN + margin),
+                 Fixed::fromInt(INNER_X_MAX - margin), Fixed::fromInt(INNER_Y_MAX - margin)};
 
-    float bulletSpeed = 8.0f;
-    bullets[index].vx = dirX * bulletSpeed;
-    bullets[index].vy = dirY * bulletSpeed;
+    spawnScatter(spawnRng, area, TARGET_RADIUS, (int)targets.size(), spawnPoints);
+    for (int i = 0; i < (int)targets.size(); ++i) {
+        targets[i] = {FieldCoord::fromFixed(spawnPoints[i].x), FieldCoord::fromFixed(spawnPoints[i].y)};
+        targetActive.set(i);
+    }
+    targetGridDirty = true;
+    targetsAlive = (int)targets.size();   // counted down by hits: no scan for the wave's end
 
-    bullets[index].active = true;
+    GameEvent e = makeEvent(EVENT_WAVE_SPAWNED);
+    e.waveSpawned = {++wave, (int)targets.size()};
+    gameEvents.publish(e);
 }
 
-// Reset / respawn all targets at RANDOM positions
-static void resetTargets() {
-    float margin = 40.0f; // keep away from curb
-    float minX = INNER_X_MIN + margin;
-    float maxX = INNER_X_MAX - margin;
-    float minY = INNER_Y_MIN + margin;
-    float maxY = INNER_Y_MAX - margin;
+// Move a tank by (dx, dy), stopping at obstacles and sliding along them,
+// and keep it inside the inner track boundaries
+static void moveTank(Car& tank, Fixed dx, Fixed dy) {
+    const Fixed zero = Fixed::fromInt(0);
+    Fixed x = tank.x.toFixed();
+    Fixed y = tank.y.toFixed();
+
+    // Two passes: move up to the contact point, then slide with what is left
+    for (int pass = 0; pass < 2; ++pass) {
+        if (dx == zero && dy == zero) break;
+
+        AABB box = {x - TANK_HALF_SIZE, y - TANK_HALF_SIZE, x + TANK_HALF_SIZE, y + TANK_HALF_SIZE};
+        ObstacleHit hit;
+        if (!sweepObstacles(box, dx, dy, hit)) {
+            x += dx;
+            y += dy;
+            break;
+        }
+
+        x += dx * hit.t + hit.nx * CONTACT_SKIN;
+        y += dy * hit.t + hit.ny * CONTACT_SKIN;
 
-    for (int i = 0; i < NUM_TARGETS; ++i) {
-        float x = randFloat(minX, maxX);
-        float y = randFloat(minY, maxY);
-        targets[i].x = x;
-        targets[i].y = y;
-        targets[i].radius = 15.0f;
-        targets[i].active = true;
+        // Remaining motion without the component into the surface
+        Fixed left = Fixed::fromInt(1) - hit.t;
+        dx = dx * left;
+        dy = dy * left;
+        if (hit.nx != zero) dx = zero;
+        if (hit.ny != zero) dy = zero;
     }
+
+    x = std::clamp(x, Fixed::fromInt(INNER_X_MIN), Fixed::fromInt(INNER_X_MAX));
+    y = std::clamp(y, Fixed::fromInt(INNER_Y_MIN), Fixed::fromInt(INNER_Y_MAX));
+    tank.x = FieldCoord::fromFixed(x);
+    tank.y = FieldCoord::fromFixed(y);
+}
+
+
+// Fog works in float pixels and degrees (visibility only, not sim state).
+// The cone looks along the barrel, so aiming the turret re-casts it too
+static void moveViewer(int id, const Car& tank) {
+    BAngle aim = tank.angle + tank.turret;
+    fogMoveViewer(id, tank.x.toFloat(), tank.y.toFloat(), bangleToDegrees(aim));
+}
+
+// One tick of driving: the ground under the tank scales its speed.
+// Model front is at negative Y in local space,
+// so forward direction is (sin(angle), -cos(angle))
+static void driveTank(Car& tank) {
+    Fixed v = tank.speed.toFixed() * terrainSpeedFactor(tank.x.toFixed(), tank.y.toFixed()) * simStepTicks;
+    moveTank(tank, v * fxSin(tank.angle), -(v * fxCos(tank.angle)));
+}
+
+// Centre of cell i of n splitting [origin, origin + span]
+static Fixed cellCentre(int origin, int span, int i, int n) {
+    int64_t offset = (int64_t)(2 * i + 1) * span * Fixed::ONE / (2 * n);
+    return Fixed::fromInt(origin) + Fixed::fromRaw((int32_t)offset);
+}
+
+// Bots stand on an even grid over the battlefield, skipping cells that
+// overlap an obstacle (reused only if there are not enough free cells)
+static void placeBots() {
+    int count = (int)bots.size();
+    if (count == 0) return;
+
+    int margin = 40;
+    int w = (INNER_X_MAX - INNER_X_MIN) - 2 * margin;
+    int h = (INNER_Y_MAX - INNER_Y_MIN) - 2 * margin;
+    int cells = count + count / 4 + 1;   // headroom for blocked cells
+    int cols  = 1;
+    while ((long long)cols * cols * h < (long long)cells * w) ++cols;   // cols / rows ~ w / h
+    int rows  = (cells + cols - 1) / cols;
+
+    int placed = 0;
+    for (int pass = 0; pass < 2 && placed < count; ++pass) {
+        for (int c = 0; c < rows * cols && placed < count; ++c) {
+            Fixed x = cellCentre(INNER_X_MIN + margin, w, c % cols, cols);
+            Fixed y = cellCentre(INNER_Y_MIN + margin, h, c / cols, rows);
+            AABB box = {x - TANK_HALF_SIZE, y - TANK_HALF_SIZE, x + TANK_HALF_SIZE, y + TANK_HALF_SIZE};
+            if (overlapsObstacle(box) != (pass == 1)) continue;   // pass 1: blocked cells only
+
+            bots[placed++] = {FieldCoord::fromFixed(x), FieldCoord::fromFixed(y), 0, 0, PackedSpeed{0}};
+        }
+    }
+}
+
+// =====================================================
+// Round scripts (sim tick coroutines, see scheduler.h)
+// =====================================================
+
+// Counts one second down every TICKS_PER_SECOND ticks, then ends the round
+static SimTask roundTimer() {
+    while (timeLeft > 0) {
+        co_await sleep_ticks(TICKS_PER_SECOND);
+        --timeLeft;
+    }
+
+    gameOver = true;
+    GameEvent e = makeEvent(EVENT_GAME_OVER);
+    e.gameOver = {score};
+    gameEvents.publish(e);
+}
+
+// Respawns a random wave whenever the last target of the current one falls;
+// score keeps accumulating wave after wave
+static SimTask waveSpawner() {
+    for (;;) {
+        co_await targetsCleared.wait();
+        resetTargets();
+    }
+}
+
+// Drops the previous round's tasks and starts this round's
+static void startRoundTasks() {
+    schedReset(simTick);
+    schedSpawn(roundTimer());
+    schedSpawn(waveSpawner());
 }
 
 // Restart game state (used by N key)
 static void restartGame() {
-    // Reset player position & movement
-    float centerX = (INNER_X_MIN + INNER_X_MAX) / 2.0f;
-    player.x = centerX;
-    player.y = INNER_Y_MIN + 50.0f;
-    player.angle = 0.0f;
-    player.speed = 0.0f;
+    // Reset player positions & movement
+    for (int i = 0; i < localPlayers; ++i) players[i] = playerStart(i, 0.0f);
+    terrainReset();
 
     // Clear bullets
-    for (int i = 0; i < MAX_BULLETS; ++i) {
-        bullets[i].active = false;
-    }
+    bulletActive.clear();
+    placeBots();
+    buildTankParts();
 
     // Reset targets
+    wave = 0;
     resetTargets();
 
     // Reset score, time, gameOver flag
     score    = 0;
-    timeLeft = 60;      // restart timer
+    timeLeft = roundSeconds;   // restart timer
     gameOver = false;
-}
-
-// Timer callback: called every 1000 ms (1 second)
-static void timerCallback(int value) {
-    if (!gameOver && timeLeft > 0) {
-        --timeLeft;
-        if (timeLeft <= 0) {
-            timeLeft = 0;
-            gameOver = true;
-        }
-    }
-
-    // Ask GLUT to redraw the screen so the timer / GAME OVER updates
-    glutPostRedisplay();
-
-    // Schedule next tick
-    glutTimerFunc(1000, timerCallback, 0);
+    startRoundTasks();
 }
 
 // =====================================================
 // Public game functions
 // =====================================================
 
-void initGame() {
-    // Seed random once
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-
+void initGraphics() {
     // Background clear color (sky)
     glClearColor(0.2f, 0.6f, 0.9f, 1.0f);
 
     // 2D projection setup
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    gsMatrixMode(GL_PROJECTION);
+    gsLoadIdentity();
     gluOrtho2D(0.0f, (float)WIDTH, 0.0f, (float)HEIGHT);
+    gsMatrixChanged();
 
-    // Enable blending for transparency (shadows, glass)
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // The blend func never changes; the command buffer turns blending on
+    // and off per batch (rcBlend)
+    gsBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
 
-    // Initialize player tank at bottom middle of track
-    float centerX = (INNER_X_MIN + INNER_X_MAX) / 2.0f; // ~400
-    player.x = centerX;
-    player.y = INNER_Y_MIN + 50.0f;   // slightly above bottom inside track
-    player.angle = 180.0f;              // facing "up"
-    player.speed = 0.0f;
+void initGame() {
+    // A different layout every run (stress / bench re-seed after this)
+    seedSpawns(static_cast<unsigned long long>(std::time(nullptr)));
+
+    // Initialize player tanks at the bottom of the track, facing "up"
+    for (int i = 0; i < localPlayers; ++i) players[i] = playerStart(i, 180.0f);
 
     // Init bullets
-    for (int i = 0; i < MAX_BULLETS; ++i) {
-        bullets[i].active = false;
-    }
+    bulletActive.clear();
+
+    // Static level geometry (before the targets, which avoid it)
+    buildLevelObstacles();
+    terrainReset();
+
+    placeBots();
+    buildTankParts();
+
+    // Line of sight of the players' tanks and their bots (after the
+    // obstacles, which block it); tank i is viewer i
+    fogClearViewers();
+    for (int i = 0; i < tankCount(); ++i) moveViewer(fogAddViewer(), tankAt(i));
+    fogUpdate();
 
     // Init + activate targets randomly
+    wave = 0;
     resetTargets();
 
     // Reset score & timer & game over
     score    = 0;
-    timeLeft = 60;   // seconds
+    timeLeft = roundSeconds;
     gameOver = false;
+    simTick  = 0;
+    startRoundTasks();
 
-    // Start timer
-    glutTimerFunc(1000, timerCallback, 0);
+    // Make the initial state visible before the sim thread starts ticking
+    publishSnapshot();
+}
+
+// =====================================================
+// Snapshot handoff (sim thread -> GLUT thread)
+// =====================================================
+
+// Three buffers: one being written by the sim, one being drawn by the GLUT
+// thread and the newest complete one in between. Ownership is swapped with a
+// single atomic exchange, so neither side ever waits for the other.
+static WorldSnapshot    snapshots[3];
+static std::atomic<int> snapshotLatest{0};   // buffer index | SNAPSHOT_FRESH
+static int              snapshotBack  = 1;   // sim thread only
+static int              snapshotFront = 2;   // GLUT thread only
+
+constexpr int SNAPSHOT_INDEX = 3;
+constexpr int SNAPSHOT_FRESH = 4;   // set when 'latest' has not been picked up yet
+
+void publishSnapshot() {
+    WorldSnapshot& s = snapshots[snapshotBack];
+    s.tick     = simTick;
+    std::copy(players, players + localPlayers, s.players);
+    s.playerCount = localPlayers;
+    s.bots     = bots;
+    s.tankParts.resize(tankParts.nodes.size());
+    for (size_t i = 0; i < tankParts.nodes.size(); ++i) s.tankParts[i] = tankParts.nodes[i].world;
+    s.bullets  = bullets;   // same size every tick after the first: no allocation
+    s.bulletActive = bulletActive;
+    s.targets  = targets;
+    s.targetActive = targetActive;
+    s.score    = score;
+    s.timeLeft = timeLeft;
+    s.gameOver = gameOver;
+    s.fogOfWar = fogOfWar;
+    s.fog      = fogCombinedMask();
+
+    // Interest management: the renderer never learns about unseen targets
+    if (fogOfWar) {
+        targetActive.forEach([&](int i) {
+            if (!fogVisible(targets[i].x.toFloat(), targets[i].y.toFloat())) s.targetActive.reset(i);
+        });
+    }
+
+    snapshotBack = snapshotLatest.exchange(snapshotBack | SNAPSHOT_FRESH,
+                                           std::memory_order_acq_rel) & SNAPSHOT_INDEX;
+}
+
+const WorldSnapshot& acquireSnapshot() {
+    if (snapshotLatest.load(std::memory_order_relaxed) & SNAPSHOT_FRESH) {
+        snapshotFront = snapshotLatest.exchange(snapshotFront, std::memory_order_acq_rel) & SNAPSHOT_INDEX;
+    }
+    return snapshots[snapshotFront];
 }
 
 void updateGame() {
+    PROFILE_SCOPE("updateGame");
+
+    if (phaseNs) phaseStart = std::chrono::steady_clock::now();
+
+    // Timers due this tick (round countdown, scripts)
+    simTick += simStepTicks;
+    schedRun(simTick);
+    endPhase(SIM_PHASE_TASKS);
+
     // If game over, freeze world (no more movement / collisions)
     if (gameOver) return;
 
     // ----- Tank movement -----
-    float rad = player.angle * (float)M_PI / 180.0f;
+    for (int i = 0; i < localPlayers; ++i) {
+        driveTank(players[i]);
+
+        // Clamp speed
+        players[i].speed = PackedSpeed::fromFixed(std::clamp(players[i].speed.toFixed(), TANK_MIN_SPEED, TANK_MAX_SPEED));
+    }
 
-    // Model front is at negative Y in local space,
-    // so forward direction is (sin(angle), -cos(angle))
-    player.x += player.speed * std::sin(rad);
-    player.y += -player.speed * std::cos(rad);
+    // Bots are steered by their scripts (speed / angle), same movement rules
+    for (Car& bot : bots) driveTank(bot);
 
-    // Keep tank inside the inner track boundaries
-    if (player.x < INNER_X_MIN) player.x = INNER_X_MIN;
-    if (player.x > INNER_X_MAX) player.x = INNER_X_MAX;
-    if (player.y < INNER_Y_MIN) player.y = INNER_Y_MIN;
-    if (player.y > INNER_Y_MAX) player.y = INNER_Y_MAX;
+    // Part matrices of the tanks that moved, turned or aimed, in one pass
+    syncTankParts(0, tankCount());
+    endPhase(SIM_PHASE_TANKS);
 
-    // Clamp speed
-    if (player.speed > 5.0f)  player.speed = 5.0f;
-    if (player.speed < -2.0f) player.speed = -2.0f;
+    // ----- Visibility (re-cast only if a tank changed cell or heading) -----
+    for (int i = 0; i < tankCount(); ++i) moveViewer(i, tankAt(i));
+    fogUpdate();
+    endPhase(SIM_PHASE_FOG);
 
     // ----- Bullets movement -----
-    for (int i = 0; i < MAX_BULLETS; ++i) {
-        if (!bullets[i].active) continue;
-
-        bullets[i].x += bullets[i].vx;
-        bullets[i].y += bullets[i].vy;
-
-        // Deactivate if bullet leaves the battlefield (inside track)
-        if (bullets[i].x < INNER_X_MIN ||
-            bullets[i].x > INNER_X_MAX ||
-            bullets[i].y < INNER_Y_MIN ||
-            bullets[i].y > INNER_Y_MAX)
-        {
-            bullets[i].active = false;
+    // Each move ends at the first obstacle or where it leaves the
+    // battlefield (inside track), and is swept against the targets right
+    // away (they do not move during this phase). Bullets that reach no
+    // target stop at their wall or fly on; the others are settled below.
+    targetHits.clear();
+    bulletActive.forEach([&](int i) {
+        Bullet& b = bullets[i];
+        Fixed x = b.x.toFixed();
+        Fixed y = b.y.toFixed();
+        Fixed dx, dy;
+        bulletVelocity(b, dx, dy);
+        dx = dx * simStepTicks;
+        dy = dy * simStepTicks;
+
+        Fixed t     = Fixed::fromInt(1);
+        bool  stops = false;
+        ObstacleHit hit;
+        if (raycastObstacles(x, y, x + dx, y + dy, hit)) {
+            t     = hit.t;
+            stops = true;
+        }
+        Fixed exit;
+        if (sweepExitBox(x, y, dx, dy, BATTLEFIELD, exit) && exit < t) {
+            t     = exit;
+            stops = true;
         }
-    }
-
-    // ----- Bullet vs Target collision -----
-    for (int t = 0; t < NUM_TARGETS; ++t) {
-        if (!targets[t].active) continue;
-
-        for (int b = 0; b < MAX_BULLETS; ++b) {
-            if (!bullets[b].active) continue;
-
-            float dx = bullets[b].x - targets[t].x;
-            float dy = bullets[b].y - targets[t].y;
-            float distSq = dx * dx + dy * dy;
-            float hitRadius = targets[t].radius + 4.0f; // bullet radius ~4
 
-            if (distSq <= hitRadius * hitRadius) {
-                // Hit!
-                targets[t].active  = false;
-                bullets[b].active  = false;
-                score += 1;
-                break; // move to next target
+        BulletPath path = {x, y, dx * t, dy * t, stops};
+        b.x = FieldCoord::fromFixed(x + path.dx);
+        b.y = FieldCoord::fromFixed(y + path.dy);
+
+        TargetHit reach;
+        reach.bullet = i;
+        reach.path   = path;
+        reach.target = firstTargetAlong(x, y, path.dx, path.dy, reach.at);
+        if (reach.target >= 0) {
+            targetHits.push_back(reach);
+        } else if (stops) {
+            bulletActive.reset(i);
+            shellImpact(x + path.dx, y + path.dy);
+        }
+    });
+    endPhase(SIM_PHASE_BULLETS);
+
+    // ----- Bullet vs Target collision (swept: nothing is stepped over) -----
+    // Settle the hits earliest first. A bullet whose target an earlier one
+    // took looks again further along its path.
+    std::make_heap(targetHits.begin(), targetHits.end(), hitsLater);
+    while (!targetHits.empty()) {
+        std::pop_heap(targetHits.begin(), targetHits.end(), hitsLater);
+        TargetHit hit = targetHits.back();
+        targetHits.pop_back();
+        const BulletPath& path = hit.path;
+
+        if (!targetActive.test(hit.target)) {
+            hit.target = firstTargetAlong(path.x0, path.y0, path.dx, path.dy, hit.at);
+            if (hit.target >= 0) {
+                targetHits.push_back(hit);
+                std::push_heap(targetHits.begin(), targetHits.end(), hitsLater);
+            } else if (path.stops) {
+                bulletActive.reset(hit.bullet);
+                shellImpact(path.x0 + path.dx, path.y0 + path.dy);
             }
+            continue;
         }
-    }
 
-    // ----- Check if all targets are destroyed -> respawn RANDOM wave -----
-    bool anyActive = false;
-    for (int t = 0; t < NUM_TARGETS; ++t) {
-        if (targets[t].active) {
-            anyActive = true;
-            break;
-        }
+        // Hit!
+        Fixed x = path.x0 + path.dx * hit.at;
+        Fixed y = path.y0 + path.dy * hit.at;
+        Bullet& b = bullets[hit.bullet];
+        b.x = FieldCoord::fromFixed(x);
+        b.y = FieldCoord::fromFixed(y);
+        bulletActive.reset(hit.bullet);
+        bulletHitsTarget(hit.bullet, hit.target, x, y);
     }
 
-    if (!anyActive) {
-        // All targets destroyed → respawn new random wave
-        resetTargets();
-        // score keeps accumulating wave after wave
-    }
+    endPhase(SIM_PHASE_COLLISION);
+
+    // ----- Tasks woken during this tick (wave respawn) -----
+    schedRun(simTick);
+    endPhase(SIM_PHASE_TASKS);
 }
 
-void drawScene() {
-    glClear(GL_COLOR_BUFFER_BIT);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+void recordTelemetry(unsigned tickMicros) {
+    telemetryRecordTick(simTick, player.x.toFloat(), player.y.toFloat(), bangleToDegrees(player.angle),
+                        score, tickMicros);
+}
+
+// Ground and static layers baked into display lists: recorded once and
+// shared by every viewport of every frame (rebaked if the level changes)
+static GLuint   groundList   = 0;
+static GLuint   staticList   = 0;
+static unsigned bakedRevision = 0;   // obstacleRevision() of the baked lists
 
-    // Static environment
+static void bakeStaticScene() {
+    if (groundList && bakedRevision == obstacleRevision()) return;
+    PROFILE_SCOPE("bakeStaticScene");
+
+    // Craters go between the ground and the rest, hence two lists
+    rcLayer(LAYER_GROUND);
     drawBackground();   // grass
     drawTrack();        // road ring
+    rcLayer(LAYER_STATIC);
     drawScenery();      // stands, trees, pit, sun
+    drawObstacles();    // walls, bunkers
+
+    groundList    = renderBake(groundList, LAYER_GROUND, LAYER_GROUND);
+    staticList    = renderBake(staticList, LAYER_STATIC, LAYER_STATIC);
+    bakedRevision = obstacleRevision();
+}
+
+void drawScene() {
+    PROFILE_SCOPE("drawScene");
+    auto frameStart = std::chrono::steady_clock::now();
+
+    // Newest complete simulation state; the sim keeps running meanwhile
+    const WorldSnapshot& world = acquireSnapshot();
+    dynresBeginFrame();
+
+    // Record the whole frame first, then submit it in one go
+    renderBeginFrame();
+    gsBeginFrame();
+
+    // Static environment (recorded only when it is not baked yet)
+    bakeStaticScene();
 
     // Apply reflection / shear to dynamic objects if toggled
+    rcLayer(LAYER_WORLD);
     applyTransformEffects();
 
     // Draw targets and tank + bullets
-    drawTargets();
-    drawPlayerTank();
-    drawBullets();
+    drawTargets(world.targets, world.targetActive);
+    for (size_t i = 0; i + TANK_PART_COUNT <= world.tankParts.size(); i += TANK_PART_COUNT) {
+        drawTank(&world.tankParts[i]);
+    }
+    drawBullets(world.bullets, world.bulletActive);
+
+    // Effects driven by the event bus (muzzle flashes, hit rings, wave banner)
+    consumeEffectEvents(world);
+    drawEffects(world.tick);
+
+    // One viewport per player, each following its tank as drawn
+    GLfloat effectsMatrix[16];
+    transformEffectsMatrix(effectsMatrix);
+    float focus[MAX_PLAYERS][2];
+    for (int p = 0; p < world.playerCount; ++p) {
+        float x = world.players[p].x.toFloat(), y = world.players[p].y.toFloat();
+        focus[p][0] = effectsMatrix[0] * x + effectsMatrix[4] * y + effectsMatrix[12];
+        focus[p][1] = effectsMatrix[1] * x + effectsMatrix[5] * y + effectsMatrix[13];
+    }
+    SplitView views[MAX_SPLIT_VIEWS];
+    int viewCount = splitLayout(world.playerCount, focus, views);
+
+    // Draw HUD (score, time, game over text, viewport captions)
+    drawHUD(world, views, viewCount);
+    drawWaveBanner(world.tick);
 
-    // Draw HUD (score, time, game over text)
-    drawHUD();
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // World at the dynamic internal resolution. Sorted and merged once;
+    // each viewport replays only the batches inside the rectangle it shows.
+    // Terrain and fog are one quad each and left to the GPU to clip
+    RenderBatches worldBatches = renderBuild(LAYER_WORLD, LAYER_WORLD);
+    dynresBeginScene();
+    for (int v = 0; v < viewCount; ++v) {
+        const SplitView& view = views[v];
+        if (viewCount > 1) splitBeginView(view);   // a single view is the default projection
+
+        renderCallBaked(groundList);
+        drawTerrain();
+        renderCallBaked(staticList);
+        renderReplay(worldBatches, view.left, view.bottom, view.width, view.height);
+
+        // Fog sits between the world and the HUD
+        if (world.fogOfWar) drawFog(world.fog, effectsMatrix);
+    }
+    if (viewCount > 1) splitEndViews();
+
+    // Upscale to the window, then the HUD at native resolution
+    dynresEndScene();
+    renderSubmit(LAYER_HUD, LAYER_HUD);
 
+    // Profiler graph on top of everything (no-op unless ENABLE_PROFILER)
+    drawProfilerOverlay();
+
+    // CPU cost for the resolution controller; the GPU side is timed by dynres
+    // without waiting for it
+    std::chrono::duration<float, std::milli> cost = std::chrono::steady_clock::now() - frameStart;
+    dynresFrameTime(cost.count());
+
+    PROFILE_SCOPE("glutSwapBuffers");
     glutSwapBuffers();
 }
 
@@ -439,49 +1190,91 @@ void drawScene() {
 // Input handling
 // =====================================================
 
-void handleKeyboard(unsigned char key, int, int) {
-    // After game over: allow ESC and N (restart)
-    if (gameOver && key != 27 && key != 'n' && key != 'N') {
+// Drives the tank of the player whose map has 'key'; false if nobody's has
+static bool applyPlayerKey(int key) {
+    for (int p = 0; p < localPlayers; ++p) {
+        const KeyMap& keys = KEY_MAPS[p];
+        Car& tank = players[p];
+
+        if      (key == keys.forward)     tank.speed = PackedSpeed::fromFixed(tank.speed.toFixed() + TANK_ACCEL);
+        else if (key == keys.back)        tank.speed = PackedSpeed::fromFixed(tank.speed.toFixed() - TANK_ACCEL);
+        else if (key == keys.left)        tank.angle += TANK_TURN_STEP;
+        else if (key == keys.right)       tank.angle -= TANK_TURN_STEP;
+        else if (key == keys.turretLeft)  tank.turret += TURRET_STEP;
+        else if (key == keys.turretRight) tank.turret -= TURRET_STEP;
+        else if (key == keys.fire)        spawnBulletFrom(p);
+        else if (key == keys.stop)        tank.speed = PackedSpeed{0};
+        else continue;
+        return true;
+    }
+    return false;
+}
+
+void applyKeyboard(unsigned char key) {
+    // After game over: only N (restart)
+    if (gameOver && key != 'n' && key != 'N') {
         return;
     }
 
     switch (key) {
-    case 'w': // accelerate forward
-        player.speed += 0.2f;
+    case 'v': // toggle fog of war
+        fogOfWar = !fogOfWar;
         break;
-    case 's': // brake / reverse
-        player.speed -= 0.2f;
+    case 'n':
+    case 'N': // restart game
+        restartGame();
+        break;
+    default:  // driving and firing
+        applyPlayerKey(key);
         break;
+    }
+}
+
+void applySpecial(int key) {
+    if (gameOver) return; // no driving after time is over
+
+    applyPlayerKey(KEY_SPECIAL + key);
+}
+
+void handleKeyboard(unsigned char key, int, int) {
+    // Render-side keys are handled here on the GLUT thread
+    switch (key) {
     case 'r': // toggle reflection
         reflectScene = !reflectScene;
-        break;
+        return;
     case 'h': // toggle shear
         shearEffect = !shearEffect;
-        break;
-    case ' ': // space -> fire
-        spawnBullet();
-        break;
-    case 'f':
-        player.speed = 0;
-        break;
-    case 'n':
-    case 'N': // restart game
-        restartGame();
-        break;
+        return;
+    case 'g': // toggle dynamic resolution
+        dynresToggle();
+        return;
+    case 'p': // toggle profiler overlay
+        profilerToggleOverlay();
+        return;
+    case 't': // export profiler trace
+        if (profilerExportTrace("frame_trace.json")) {
+            std::printf("Profiler trace written to frame_trace.json\n");
+        }
+        return;
+    case 'd': { // dump the last recorded frame's render commands
+        std::FILE* out = std::fopen("render_dump.txt", "w");
+        if (out) {
+            renderDumpFrame(out);
+            std::fclose(out);
+            std::printf("Render commands written to render_dump.txt\n");
+        }
+        return;
+    }
     case 27:  // ESC key
+        stopSimThread();
+        telemetryClose();
         exit(0);
     }
+
+    // Everything else is gameplay: hand it to the sim thread
+    queueKeyboard(key);
 }
 
 void handleSpecial(int key, int, int) {
-    if (gameOver) return; // no turning after time is over
-
-    switch (key) {
-    case GLUT_KEY_LEFT:
-        player.angle += 5.0f;   // rotate left
-        break;
-    case GLUT_KEY_RIGHT:
-        player.angle -= 5.0f;   // rotate right
-        break;
-    }
+    queueSpecial(key);
 }
@@ -2,37 +2,176 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <vector>
+
+#include "compact.h"     // FieldCoord, PackedSpeed, ActiveBits (stored entity state)
+#include "fog.h"         // FogMask
+#include "fixed.h"       // Fixed, BAngle (sim state is fixed point, see fixed.h)
+#include "transform.h"   // Affine2 (tank part matrices)
+
 // --- Constants ---
 
 // Window size (defined in the header, making them compile-time constants)
 constexpr int WIDTH = 800;
 constexpr int HEIGHT = 600;
 
+// Simulation rate (the sim runs on its own thread, see simthread.h)
+constexpr int TICKS_PER_SECOND = 60;
+
+// Default entity pool sizes (see setEntityCounts)
+constexpr int MAX_BULLETS = 20;
+constexpr int NUM_TARGETS = 5;
+
+// Local split-screen players (see setPlayerCount)
+constexpr int MAX_PLAYERS = 4;
+
 // --- Data Structures ---
+// Entities are stored compact (compact.h) and unpacked to Fixed for the math;
+// what every entity of a type shares (bullet speed, target radius) is a
+// constant in game.cpp and whether a pool slot is in use is a bit in the
+// pool's ActiveBits.
 
-// Car state
+// Car state (10 bytes)
 struct Car {
-    float x, y;
-    float angle;    // in degrees
-    float speed;
+    FieldCoord  x, y;
+    BAngle      angle;    // binary angle, 0 = facing down the screen (-Y)
+    BAngle      turret;   // turret heading relative to the hull
+    PackedSpeed speed;    // px per tick
+};
+
+// Parts of a tank in its transform hierarchy (hull -> turret -> barrel);
+// every tank owns TANK_PART_COUNT consecutive nodes in this order
+enum TankPart {
+    TANK_HULL,
+    TANK_TURRET,
+    TANK_BARREL,
+    TANK_PART_COUNT
+};
+
+// Bullet (6 bytes): flies at BULLET_SPEED along its heading
+struct Bullet {
+    FieldCoord x, y;
+    BAngle     heading;   // same convention as Car::angle
+};
+
+// Target (4 bytes): a circle of TARGET_RADIUS
+struct Target {
+    FieldCoord x, y;
+};
+
+// Immutable copy of the simulation state handed to the renderer.
+// The sim thread fills one of three buffers per tick (publishSnapshot) and
+// the GLUT thread draws the newest complete one (acquireSnapshot).
+struct WorldSnapshot {
+    unsigned long long   tick;
+    Car                  players[MAX_PLAYERS];
+    int                  playerCount;
+    std::vector<Car>     bots;
+    std::vector<Affine2> tankParts;   // TANK_PART_COUNT world matrices per tank, players first
+    std::vector<Bullet>  bullets;
+    ActiveBits           bulletActive;
+    std::vector<Target>  targets;
+    ActiveBits           targetActive;   // unseen targets cleared if fogOfWar
+    int                  score;
+    int                  timeLeft;
+    bool                 gameOver;
+    bool                 fogOfWar;    // targets outside 'fog' are already hidden
+    FogMask              fog;         // what the players' tanks can see
 };
 
 // --- Global State Declarations (Defined in game.cpp) ---
+// Owned by the simulation thread; the renderer only reads WorldSnapshot.
+
+// Local players: players[0] (= player) is the single-player tank, the
+// others only drive when setPlayerCount() asked for split-screen
+extern Car  players[MAX_PLAYERS];
+extern Car& player;
+
+// Scripted allied tanks (stress runs, see stress.h); empty in normal play
+extern std::vector<Car> bots;
 
-extern Car player;
+// Entity pools (sized by setEntityCounts, MAX_BULLETS / NUM_TARGETS by default)
+// and which of their slots are in use
+extern std::vector<Bullet> bullets;
+extern std::vector<Target> targets;
+extern ActiveBits          bulletActive;
+extern ActiveBits          targetActive;
 
-// Transformation toggles
+// Transformation toggles (render-side only, GLUT thread)
 extern bool reflectScene;
 extern bool shearEffect;
 
 // --- Game Logic Functions (Defined in game.cpp) ---
 
+void initGraphics();   // GL state (projection, blending); needs a current context
 void initGame();
-void updateGame();
-void drawScene();
+void updateGame();     // one simulation tick
+void drawScene();      // draws the latest snapshot
+
+// Appends this tick to the telemetry log (sim thread, after updateGame)
+void recordTelemetry(unsigned tickMicros);
+
+// Triple-buffered, lock-free handoff between the sim and GLUT threads
+void publishSnapshot();                    // sim thread, after each tick
+const WorldSnapshot& acquireSnapshot();    // GLUT thread, once per frame
+
+// Sim-side input: applied by the sim thread when it drains the input queue
+void applyKeyboard(unsigned char key);
+void applySpecial(int key);
+
+// Resize the bullet / target pools (benchmarks, stress runs); call before initGame()
+void setEntityCounts(int bulletSlots, int targetCount);
+
+// Resize the bot pool; call before initGame(). Bots share the bullet pool,
+// score and line of sight with the player
+void setBotCount(int count);
+
+// Local players, 1 (default) to MAX_PLAYERS; call before initGame(). Each
+// drives with its own keys and gets its own split-screen viewport; they share
+// the world, bullets, score and line of sight
+void setPlayerCount(int count);
+int  playerCount();
+
+// Round length in seconds (default 60), applied by initGame() / restart
+void setRoundSeconds(int seconds);
+
+// Sim phases timed during updateGame() when enabled (stress runs)
+enum SimPhase {
+    SIM_PHASE_TASKS,       // scheduler: round timer, waves, scripts
+    SIM_PHASE_TANKS,       // tank movement against obstacles
+    SIM_PHASE_FOG,         // line-of-sight update
+    SIM_PHASE_BULLETS,     // bullet movement, obstacle raycasts, target sweeps
+    SIM_PHASE_COLLISION,   // target hits settled in order of impact
+    SIM_PHASE_COUNT
+};
+
+// Adds each phase's nanoseconds to ns[SIM_PHASE_COUNT] on every tick;
+// nullptr (default) turns the timing off
+void setSimPhaseTimes(double* ns);
+
+// Fast-forward: each updateGame() advances 'ticks' base ticks (default 1).
+// Tank moves are swept against obstacles and bullets against obstacles,
+// targets and the battlefield edge, so large steps still give the same hits;
+// timers fire at their own base tick (see schedRun)
+void setSimStepTicks(int ticks);
+
+// Fire from the player tank / any tank (no-op if no bullet slot is free).
+// Tanks 0 .. playerCount() - 1 are the players, then bots[0], bots[1] ...
+void spawnBullet();
+void spawnBulletFrom(int tank);
+
+// Seeds the target placement stream: the same seed gives the same waves
+// (initGame seeds from the clock)
+void seedSpawns(unsigned long long seed);
+
+// Respawn every target at a random position (new wave); targets never
+// overlap each other or an obstacle unless the wave is too big to fit (spawn.h)
+void resetTargets();
 
 // --- Input Handlers (GLUT Callbacks) ---
 
+// Render-side keys are handled immediately, gameplay keys are queued for the
+// sim thread, where each player's key map picks the tank they drive.
 // Signature simplified by removing unused parameter names (x, y)
 void handleKeyboard(unsigned char key, int, int);
 void handleSpecial(int key, int, int);
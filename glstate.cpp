@@ -0,0 +1,185 @@
+// glstate.cpp
+#include <GL/glut.h>
+#include <cstring>
+
+#include "glstate.h"
+#include "profiler.h"  // must stay last: hooks GL calls when profiling
+
+// =====================================================
+// Shadow state
+// =====================================================
+
+enum Known : unsigned char {
+    UNKNOWN = 0,
+    OFF,
+    ON
+};
+
+enum CachedCap {
+    CAP_BLEND = 0,
+    CAP_TEXTURE_2D,
+    CAP_COUNT,
+    CAP_NONE = CAP_COUNT
+};
+
+enum CachedMatrix {
+    MATRIX_MODELVIEW = 0,
+    MATRIX_PROJECTION,
+    MATRIX_COUNT
+};
+
+// Zero / negative values mean "unknown": the next set reaches GL
+struct ShadowState {
+    Known   caps[CAP_COUNT]        = {};
+    Known   vertexArray            = UNKNOWN;
+    bool    blendFuncSet           = false;
+    GLenum  blendSrc               = 0;
+    GLenum  blendDst               = 0;
+    bool    colorSet               = false;
+    GLfloat color[4]               = {};
+    GLfloat lineWidth              = -1.0f;
+    bool    textureSet             = false;
+    GLuint  texture                = 0;
+    GLint   unpackAlignment        = -1;
+    GLint   unpackRowLength        = -1;
+    GLenum  matrixMode             = 0;
+    bool    identity[MATRIX_COUNT] = {};
+};
+
+static ShadowState  shadow;
+static GlStateStats stats;
+
+// True (and counted as issued) if the call has to reach GL
+static bool changes(bool differs) {
+    if (differs) ++stats.issued;
+    else         ++stats.skipped;
+    return differs;
+}
+
+static CachedCap cachedCap(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:      return CAP_BLEND;
+    case GL_TEXTURE_2D: return CAP_TEXTURE_2D;
+    default:            return CAP_NONE;
+    }
+}
+
+// Index into shadow.identity, or -1 when the current mode is not tracked
+static int currentMatrix() {
+    switch (shadow.matrixMode) {
+    case GL_MODELVIEW:  return MATRIX_MODELVIEW;
+    case GL_PROJECTION: return MATRIX_PROJECTION;
+    default:            return -1;
+    }
+}
+
+// =====================================================
+// Frame
+// =====================================================
+
+void gsBeginFrame() {
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+void gsInvalidate() {
+    shadow = ShadowState{};
+}
+
+const GlStateStats& gsStats() {
+    return stats;
+}
+
+// =====================================================
+// State
+// =====================================================
+
+static void setCap(GLenum cap, bool on) {
+    CachedCap c = cachedCap(cap);
+    Known want = on ? ON : OFF;
+    if (c != CAP_NONE) {
+        if (!changes(shadow.caps[c] != want)) return;
+        shadow.caps[c] = want;
+    } else {
+        ++stats.issued;
+    }
+
+    if (on) glEnable(cap);
+    else    glDisable(cap);
+}
+
+void gsEnable(GLenum cap)  { setCap(cap, true); }
+void gsDisable(GLenum cap) { setCap(cap, false); }
+
+void gsBlendFunc(GLenum src, GLenum dst) {
+    if (!changes(!shadow.blendFuncSet || shadow.blendSrc != src || shadow.blendDst != dst)) return;
+    shadow.blendFuncSet = true;
+    shadow.blendSrc     = src;
+    shadow.blendDst     = dst;
+    glBlendFunc(src, dst);
+}
+
+void gsColor4fv(const GLfloat color[4]) {
+    if (!changes(!shadow.colorSet || std::memcmp(shadow.color, color, sizeof(shadow.color)) != 0)) return;
+    shadow.colorSet = true;
+    std::memcpy(shadow.color, color, sizeof(shadow.color));
+    glColor4fv(color);
+}
+
+void gsLineWidth(GLfloat width) {
+    if (!changes(shadow.lineWidth != width)) return;
+    shadow.lineWidth = width;
+    glLineWidth(width);
+}
+
+void gsBindTexture2D(GLuint texture) {
+    if (!changes(!shadow.textureSet || shadow.texture != texture)) return;
+    shadow.textureSet = true;
+    shadow.texture    = texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void gsPixelStorei(GLenum name, GLint value) {
+    GLint* cached = name == GL_UNPACK_ALIGNMENT  ? &shadow.unpackAlignment :
+                    name == GL_UNPACK_ROW_LENGTH ? &shadow.unpackRowLength : nullptr;
+    if (cached) {
+        if (!changes(*cached != value)) return;
+        *cached = value;
+    } else {
+        ++stats.issued;
+    }
+    glPixelStorei(name, value);
+}
+
+void gsEnableVertexArray() {
+    if (!changes(shadow.vertexArray != ON)) return;
+    shadow.vertexArray = ON;
+    glEnableClientState(GL_VERTEX_ARRAY);
+}
+
+// =====================================================
+// Matrices
+// =====================================================
+
+void gsMatrixMode(GLenum mode) {
+    if (!changes(shadow.matrixMode != mode)) return;
+    shadow.matrixMode = mode;
+    glMatrixMode(mode);
+}
+
+void gsLoadIdentity() {
+    int m = currentMatrix();
+    if (!changes(m < 0 || !shadow.identity[m])) return;
+    if (m >= 0) shadow.identity[m] = true;
+    glLoadIdentity();
+}
+
+void gsLoadMatrixf(const GLfloat m[16]) {
+    ++stats.issued;
+    gsMatrixChanged();
+    glLoadMatrixf(m);
+}
+
+void gsMatrixChanged() {
+    int m = currentMatrix();
+    if (m >= 0) shadow.identity[m] = false;
+}
@@ -0,0 +1,64 @@
+// glstate.h
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include <GL/gl.h>
+
+// GL state cache.
+//
+// Every piece of fixed-function state the frame sets (blend, texturing, the
+// bound texture, current color, line width, unpack alignment, matrix mode,
+// an identity modelview, the vertex array) goes through these gs* calls
+// instead of GL. Each keeps a shadow copy of the last value it issued and
+// drops the call when nothing would change, so the state the command buffer
+// leaves behind carries over into the terrain / fog / upscale passes and into
+// the next frame instead of being set again.
+//
+// The shadow starts unknown (first set always reaches GL). Code that changes
+// the same state with raw GL calls (the profiler overlay) must call
+// gsInvalidate() afterwards.
+//
+// Per-frame counters tell how many state calls were issued and how many were
+// dropped; draws merged by the command buffer are in RenderStats.
+
+struct GlStateStats {
+    int issued;    // state calls that reached GL this frame
+    int skipped;   // redundant ones dropped
+};
+
+// --- Frame (Defined in glstate.cpp, GLUT thread only) ---
+
+// Resets the counters (the cached state itself carries over)
+void gsBeginFrame();
+
+// Forgets the cached state: the next set of everything reaches GL
+void gsInvalidate();
+
+const GlStateStats& gsStats();
+
+// --- State ---
+
+// GL_BLEND and GL_TEXTURE_2D are cached; other caps always reach GL
+void gsEnable(GLenum cap);
+void gsDisable(GLenum cap);
+void gsBlendFunc(GLenum src, GLenum dst);
+void gsColor4fv(const GLfloat color[4]);
+void gsLineWidth(GLfloat width);
+void gsBindTexture2D(GLuint texture);
+void gsPixelStorei(GLenum name, GLint value);   // GL_UNPACK_ALIGNMENT / GL_UNPACK_ROW_LENGTH cached
+void gsEnableVertexArray();
+
+// --- Matrices ---
+
+void gsMatrixMode(GLenum mode);
+
+// Skipped when the current matrix is known to be the identity already
+void gsLoadIdentity();
+
+// Always reaches GL; the matrix is no longer known to be the identity
+void gsLoadMatrixf(const GLfloat m[16]);
+
+// For raw matrix calls (gluOrtho2D ...) made on the current matrix
+void gsMatrixChanged();
+
+#endif // GLSTATE_H
@@ -2,6 +2,9 @@
 #include <cmath>
 #include <algorithm>
 #include "graphics.h"
+#include "render.h"     // rcBegin / rcVertex2f / rcEnd command recording
+#include "obstacles.h"  // levelObstacles
+#include "profiler.h"   // PROFILE_SCOPE (must stay last: hooks GL calls when profiling)
 
 // --- Global Constants ---
 
@@ -46,6 +49,12 @@ namespace Colors {
 
     const GLfloat SUN[]           = {1.00f, 0.90f, 0.00f};
 
+    // Obstacles
+    const GLfloat WALL[]          = {0.55f, 0.50f, 0.42f};   // concrete
+    const GLfloat WALL_TOP[]      = {0.68f, 0.63f, 0.54f};
+    const GLfloat BUNKER[]        = {0.36f, 0.40f, 0.28f};   // olive sandbags
+    const GLfloat BUNKER_TOP[]    = {0.46f, 0.50f, 0.36f};
+
     // -------------------------------------------------------------
     // Car - REALISTIC STANDARD COLORS (Dark Metallic Grey Theme)
     // -------------------------------------------------------------
@@ -76,17 +85,17 @@ namespace Colors {
 // --- Primitive Drawing Utilities ---
 
 void putPixel(int x, int y) {
-    glBegin(GL_POINTS);
-    glVertex2i(x, y);
-    glEnd();
+    rcBegin(GL_POINTS);
+    rcVertex2f(x, y);
+    rcEnd();
 }
 
 void setGlColor(const GLfloat color[3]) {
-    glColor3fv(color);
+    rcColor3fv(color);
 }
 
 void setGlColorAlpha(const GLfloat color[4]) {
-    glColor4fv(color);
+    rcColor4fv(color);
 }
 
 // ----- DDA Line Algorithm -----
@@ -105,14 +114,14 @@ void drawLineDDA(int x1, int y1, int x2, int y2) {
     float x = (float)x1;
     float y = (float)y1;
 
-    glBegin(GL_POINTS);
+    rcBegin(GL_POINTS);
     for (int i = 0; i <= steps; ++i) {
         // Rounding to the nearest integer pixel
-        glVertex2i((int)std::round(x), (int)std::round(y));
+        rcVertex2f((int)std::round(x), (int)std::round(y));
         x += xInc;
         y += yInc;
     }
-    glEnd();
+    rcEnd();
 }
 
 // ----- Bresenham Line Algorithm -----
@@ -127,9 +136,9 @@ void drawLineBresenham(int x1, int y1, int x2, int y2) {
     int x = x1;
     int y = y1;
 
-    glBegin(GL_POINTS);
+    rcBegin(GL_POINTS);
     while (true) {
-        glVertex2i(x, y);
+        rcVertex2f(x, y);
         if (x == x2 && y == y2) break;
 
         int e2 = 2 * err; // Decision parameter update
@@ -143,7 +152,7 @@ void drawLineBresenham(int x1, int y1, int x2, int y2) {
             y += sy;
         }
     }
-    glEnd();
+    rcEnd();
 }
 
 // ----- Midpoint Circle Algorithm -----
@@ -155,19 +164,20 @@ void drawCircleMidpoint(int xc, int yc, int r) {
     int d = 1 - r;
 
     // Lambda for 8-way symmetry plotting
+    // All points go into a single GL_POINTS command instead of one per pixel.
     auto plot8 = [&](int x, int y) {
-        // Using putPixel for single point drawing (avoiding repeated glBegin/glEnd calls)
-        // for better performance, these would be collected into a single list outside the loop.
-        putPixel(xc + x, yc + y);
-        putPixel(xc - x, yc + y);
-        putPixel(xc + x, yc - y);
-        putPixel(xc - x, yc - y);
-        putPixel(xc + y, yc + x);
-        putPixel(xc - y, yc + x);
-        putPixel(xc + y, yc - x);
-        putPixel(xc - y, yc - x);
+        rcVertex2f(xc + x, yc + y);
+        rcVertex2f(xc - x, yc + y);
+        rcVertex2f(xc + x, yc - y);
+        rcVertex2f(xc - x, yc - y);
+        rcVertex2f(xc + y, yc + x);
+        rcVertex2f(xc - y, yc + x);
+        rcVertex2f(xc + y, yc - x);
+        rcVertex2f(xc - y, yc - x);
     };
 
+    rcBegin(GL_POINTS);
+
     plot8(x, y);
     while (x < y) {
         x++;
@@ -179,18 +189,19 @@ void drawCircleMidpoint(int xc, int yc, int r) {
         }
         plot8(x, y);
     }
+    rcEnd();
 }
 
 // ----- Filled Circle (for sun and tree leaves) -----
 void drawFilledCircle(float cx, float cy, float r, const GLfloat color[3]) {
-    glColor3fv(color);
-    glBegin(GL_TRIANGLE_FAN);
-        glVertex2f(cx, cy);   // center
+    rcColor3fv(color);
+    rcBegin(GL_TRIANGLE_FAN);
+        rcVertex2f(cx, cy);   // center
         for (int angle = 0; angle <= 360; angle++) {
             float rad = angle * 3.14159f / 180.0f;
-            glVertex2f(cx + cos(rad) * r, cy + sin(rad) * r);
+            rcVertex2f(cx + cos(rad) * r, cy + sin(rad) * r);
         }
-    glEnd();
+    rcEnd();
 }
 
 
@@ -198,34 +209,38 @@ void drawFilledCircle(float cx, float cy, float r, const GLfloat color[3]) {
 
 // Renders the solid background color (grass)
 void drawBackground() {
+    PROFILE_SCOPE("drawBackground");
+
     setGlColor(Colors::GRASS);
-    glBegin(GL_POLYGON);
-        glVertex2i(0, 0);
-        glVertex2i(WINDOW_WIDTH, 0);
-        glVertex2i(WINDOW_WIDTH, WINDOW_HEIGHT);
-        glVertex2i(0, WINDOW_HEIGHT);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(0, 0);
+        rcVertex2f(WINDOW_WIDTH, 0);
+        rcVertex2f(WINDOW_WIDTH, WINDOW_HEIGHT);
+        rcVertex2f(0, WINDOW_HEIGHT);
+    rcEnd();
 }
 
 // Renders the track surface, borders, and lane markings
 void drawTrack() {
+    PROFILE_SCOPE("drawTrack");
+
     // 1. Asphalt road area
     setGlColor(Colors::ASPHALT);
-    glBegin(GL_POLYGON);
-        glVertex2i(TRACK_X_MIN, TRACK_Y_MIN);
-        glVertex2i(TRACK_X_MAX, TRACK_Y_MIN);
-        glVertex2i(TRACK_X_MAX, TRACK_Y_MAX);
-        glVertex2i(TRACK_X_MIN, TRACK_Y_MAX);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(TRACK_X_MIN, TRACK_Y_MIN);
+        rcVertex2f(TRACK_X_MAX, TRACK_Y_MIN);
+        rcVertex2f(TRACK_X_MAX, TRACK_Y_MAX);
+        rcVertex2f(TRACK_X_MIN, TRACK_Y_MAX);
+    rcEnd();
 
     // 2. Outer white border (using Bresenham for line segments)
-    glLineWidth(3.0f);
+    rcLineWidth(3.0f);
     setGlColor(Colors::WHITE);
     drawLineBresenham(TRACK_X_MIN, TRACK_Y_MIN, TRACK_X_MAX, TRACK_Y_MIN);
     drawLineBresenham(TRACK_X_MAX, TRACK_Y_MIN, TRACK_X_MAX, TRACK_Y_MAX);
     drawLineBresenham(TRACK_X_MAX, TRACK_Y_MAX, TRACK_X_MIN, TRACK_Y_MAX);
     drawLineBresenham(TRACK_X_MIN, TRACK_Y_MAX, TRACK_X_MIN, TRACK_Y_MIN);
-    glLineWidth(1.0f); // Reset line thickness
+    rcLineWidth(1.0f); // Reset line thickness
 
     // 3. Inner "curb" border (red & white segments using DDA)
     // Top and bottom curbs
@@ -260,63 +275,71 @@ void drawTrack() {
     constexpr int END_X = CENTER_X + 20;
     constexpr int CELL_SIZE = 5;
 
+    // Cells never overlap, so all black and all white cells can be batched
+    rcBeginUnordered();
     for (int x = START_X; x < END_X; x += CELL_SIZE) {
         for (int y = FINISH_Y; y < FINISH_Y + FINISH_HEIGHT; y += CELL_SIZE) {
             bool isBlack = ((x / CELL_SIZE) + (y / CELL_SIZE)) % 2 == 0;
             if (isBlack) setGlColor(Colors::BLACK);
             else setGlColor(Colors::WHITE);
 
-            glBegin(GL_POLYGON);
-                glVertex2i(x, y);
-                glVertex2i(x + CELL_SIZE, y);
-                glVertex2i(x + CELL_SIZE, y + CELL_SIZE);
-                glVertex2i(x, y + CELL_SIZE);
-            glEnd();
+            rcBegin(GL_POLYGON);
+                rcVertex2f(x, y);
+                rcVertex2f(x + CELL_SIZE, y);
+                rcVertex2f(x + CELL_SIZE, y + CELL_SIZE);
+                rcVertex2f(x, y + CELL_SIZE);
+            rcEnd();
         }
     }
+    rcEndUnordered();
 }
 
 // Renders non-essential trackside elements
 void drawScenery() {
+    PROFILE_SCOPE("drawScenery");
+
     // 1. Audience stands at top (outside track)
     setGlColor(Colors::STAND_BASE);
-    glBegin(GL_POLYGON);
-        glVertex2i(100, 500);
-        glVertex2i(700, 500);
-        glVertex2i(750, 580);
-        glVertex2i(50, 580);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(100, 500);
+        rcVertex2f(700, 500);
+        rcVertex2f(750, 580);
+        rcVertex2f(50, 580);
+    rcEnd();
 
     // Lighter "seats"
     setGlColor(Colors::SEATS);
-    glBegin(GL_POLYGON);
-        glVertex2i(120, 510);
-        glVertex2i(680, 510);
-        glVertex2i(720, 570);
-        glVertex2i(80, 570);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(120, 510);
+        rcVertex2f(680, 510);
+        rcVertex2f(720, 570);
+        rcVertex2f(80, 570);
+    rcEnd();
 
     // 2. Pit building on left side
     setGlColor(Colors::PIT_BUILDING);
-    glBegin(GL_POLYGON);
-        glVertex2i(40, 180);
-        glVertex2i(110, 180);
-        glVertex2i(110, 320);
-        glVertex2i(40, 320);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(40, 180);
+        rcVertex2f(110, 180);
+        rcVertex2f(110, 320);
+        rcVertex2f(40, 320);
+    rcEnd();
 
     // Windows
     setGlColor(Colors::WINDOW_GLASS);
     for (int y = 190; y < 310; y += 30) {
-        glBegin(GL_POLYGON);
-            glVertex2i(50,  y);
-            glVertex2i(100, y);
-            glVertex2i(100, y + 20);
-            glVertex2i(50,  y + 20);
-        glEnd();
+        rcBegin(GL_POLYGON);
+            rcVertex2f(50,  y);
+            rcVertex2f(100, y);
+            rcVertex2f(100, y + 20);
+            rcVertex2f(50,  y + 20);
+        rcEnd();
     }
 
 // 3. Simple realistic trees (3 filled circles, same color) with more spacing
+    // Trees do not overlap each other and outlines sort after fills, so the
+    // four trees are batched into one trunk, one leaves and one outline draw.
+    rcBeginUnordered();
     for (int i = 0; i < 4; ++i) {
         constexpr int TX_BASE  = 720;
         constexpr int TY_START = 150;     // shift start lower or higher if needed
@@ -325,12 +348,12 @@ void drawScenery() {
 
         // --- Trunk ---
         setGlColor(Colors::TREE_TRUNK);
-        glBegin(GL_POLYGON);
-            glVertex2i(tx - 6, ty - 25);
-            glVertex2i(tx + 6, ty - 25);
-            glVertex2i(tx + 6, ty + 10);
-            glVertex2i(tx - 6, ty + 10);
-        glEnd();
+        rcBegin(GL_POLYGON);
+            rcVertex2f(tx - 6, ty - 25);
+            rcVertex2f(tx + 6, ty - 25);
+            rcVertex2f(tx + 6, ty + 10);
+            rcVertex2f(tx - 6, ty + 10);
+        rcEnd();
 
         // --- LEAVES (3 filled circles) ---
         drawFilledCircle(tx,      ty + 32, 20, Colors::TREE_LEAVES); // center
@@ -343,43 +366,97 @@ void drawScenery() {
         drawCircleMidpoint(tx - 15, ty + 30, 18);
         drawCircleMidpoint(tx + 15, ty + 30, 18);
     }
+    rcEndUnordered();
 }
 
+// Renders walls and bunkers from the level geometry (the pit building is
+// part of drawScenery)
+void drawObstacles() {
+    PROFILE_SCOPE("drawObstacles");
+
+    // Obstacles never overlap each other, but a top face and outline lie on
+    // their own fill: all fills go in one unordered group, then the tops and
+    // outlines (which do not touch) in a second one drawn after it
+    const std::vector<Obstacle>& level = levelObstacles();
+    rcBeginUnordered();
+    for (const Obstacle& o : level) {
+        if (o.kind == OBSTACLE_BUILDING) continue;
+
+        float minX = o.box.minX.toFloat(), minY = o.box.minY.toFloat();
+        float maxX = o.box.maxX.toFloat(), maxY = o.box.maxY.toFloat();
+        setGlColor(o.kind == OBSTACLE_WALL ? Colors::WALL : Colors::BUNKER);
+        rcBegin(GL_QUADS);
+            rcVertex2f(minX, minY);
+            rcVertex2f(maxX, minY);
+            rcVertex2f(maxX, maxY);
+            rcVertex2f(minX, maxY);
+        rcEnd();
+    }
+    rcEndUnordered();
+
+    rcBeginUnordered();
+    for (const Obstacle& o : level) {
+        if (o.kind == OBSTACLE_BUILDING) continue;
 
-// Renders the detailed TANK body using local coordinates (relative to tank's center)
-void drawCarBody() {
-    // Coordinate system:
-    //  - X: left/right
-    //  - Y: up/down
-    //  - FRONT of tank is towards NEGATIVE Y (to match movement code)
+        float minX = o.box.minX.toFloat(), minY = o.box.minY.toFloat();
+        float maxX = o.box.maxX.toFloat(), maxY = o.box.maxY.toFloat();
+
+        // Lighter top face, inset by 3 px
+        setGlColor(o.kind == OBSTACLE_WALL ? Colors::WALL_TOP : Colors::BUNKER_TOP);
+        rcBegin(GL_QUADS);
+            rcVertex2f(minX + 3, minY + 3);
+            rcVertex2f(maxX - 3, minY + 3);
+            rcVertex2f(maxX - 3, maxY - 3);
+            rcVertex2f(minX + 3, maxY - 3);
+        rcEnd();
+
+        setGlColor(Colors::BLACK);
+        rcBegin(GL_LINE_LOOP);
+            rcVertex2f(minX, minY);
+            rcVertex2f(maxX, minY);
+            rcVertex2f(maxX, maxY);
+            rcVertex2f(minX, maxY);
+        rcEnd();
+    }
+    rcEndUnordered();
+}
+
+// Tank parts, each in its own local coordinates (see the part hierarchy in
+// game.cpp). Coordinate system:
+//  - X: left/right
+//  - Y: up/down
+//  - FRONT of every part is towards NEGATIVE Y (to match movement code)
+
+// Hull: shadow, tracks, body and armour plate; origin at the tank's center
+void drawTankHull() {
+    PROFILE_SCOPE("drawTankHull");
 
     // --- SHADOW ---
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    rcBlend(true);
     setGlColorAlpha(Colors::CAR_SHADOW);
-    glBegin(GL_POLYGON);
-        glVertex2f(-22, -30); glVertex2f(22, -30);
-        glVertex2f(24, -20);  glVertex2f(24, 20);
-        glVertex2f(22, 30);   glVertex2f(-22, 30);
-        glVertex2f(-24, 20);  glVertex2f(-24, -20);
-    glEnd();
-    glDisable(GL_BLEND);
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-22, -30); rcVertex2f(22, -30);
+        rcVertex2f(24, -20);  rcVertex2f(24, 20);
+        rcVertex2f(22, 30);   rcVertex2f(-22, 30);
+        rcVertex2f(-24, 20);  rcVertex2f(-24, -20);
+    rcEnd();
+    rcBlend(false);
 
     // --- TANK TRACKS (left & right) ---
     setGlColor(Colors::CAR_TIRE_DARK);
-    glBegin(GL_POLYGON); // left track
-        glVertex2f(-22, -26);
-        glVertex2f(-14, -26);
-        glVertex2f(-14,  26);
-        glVertex2f(-22,  26);
-    glEnd();
-
-    glBegin(GL_POLYGON); // right track
-        glVertex2f(14, -26);
-        glVertex2f(22, -26);
-        glVertex2f(22,  26);
-        glVertex2f(14,  26);
-    glEnd();
+    rcBegin(GL_POLYGON); // left track
+        rcVertex2f(-22, -26);
+        rcVertex2f(-14, -26);
+        rcVertex2f(-14,  26);
+        rcVertex2f(-22,  26);
+    rcEnd();
+
+    rcBegin(GL_POLYGON); // right track
+        rcVertex2f(14, -26);
+        rcVertex2f(22, -26);
+        rcVertex2f(22,  26);
+        rcVertex2f(14,  26);
+    rcEnd();
 
     // Track wheels (simple small circles using midpoint)
     setGlColor(Colors::CAR_RIM_METALLIC);
@@ -395,109 +472,121 @@ void drawCarBody() {
 
     // --- MAIN HULL (body) ---
     setGlColor(Colors::CAR_BODY_PRIMARY);
-    glBegin(GL_POLYGON);
-        glVertex2f(-14, -24);
-        glVertex2f( 14, -24);
-        glVertex2f( 14,  24);
-        glVertex2f(-14,  24);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-14, -24);
+        rcVertex2f( 14, -24);
+        rcVertex2f( 14,  24);
+        rcVertex2f(-14,  24);
+    rcEnd();
 
     // Side highlight on left
     setGlColor(Colors::CAR_BODY_HIGHLIGHT);
-    glBegin(GL_POLYGON);
-        glVertex2f(-14, -24);
-        glVertex2f( -8, -24);
-        glVertex2f( -8,  24);
-        glVertex2f(-14,  24);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-14, -24);
+        rcVertex2f( -8, -24);
+        rcVertex2f( -8,  24);
+        rcVertex2f(-14,  24);
+    rcEnd();
 
     // --- TOP PLATE / ARMOR ---
     setGlColor(Colors::CAR_ACCENT_STRIPE);
-    glBegin(GL_POLYGON);
-        glVertex2f(-10, -14);
-        glVertex2f( 10, -14);
-        glVertex2f( 10,  10);
-        glVertex2f(-10,  10);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-10, -14);
+        rcVertex2f( 10, -14);
+        rcVertex2f( 10,  10);
+        rcVertex2f(-10,  10);
+    rcEnd();
+
+    // --- OUTLINE ---
+    setGlColor(Colors::BLACK);
+    rcLineWidth(1.0f);
+
+    // Hull outline
+    rcBegin(GL_LINE_LOOP);
+        rcVertex2f(-14, -24);
+        rcVertex2f( 14, -24);
+        rcVertex2f( 14,  24);
+        rcVertex2f(-14,  24);
+    rcEnd();
+
+    // Tracks outline
+    rcBegin(GL_LINE_LOOP);
+        rcVertex2f(-22, -26);
+        rcVertex2f(-14, -26);
+        rcVertex2f(-14,  26);
+        rcVertex2f(-22,  26);
+    rcEnd();
+
+    rcBegin(GL_LINE_LOOP);
+        rcVertex2f(14, -26);
+        rcVertex2f(22, -26);
+        rcVertex2f(22,  26);
+        rcVertex2f(14,  26);
+    rcEnd();
+}
+
+// Turret: base and hatch; origin at the pivot (hull center)
+void drawTankTurret() {
+    PROFILE_SCOPE("drawTankTurret");
 
     // --- TURRET BASE ---
     setGlColor(Colors::CAR_CABIN_DARK);
-    glBegin(GL_POLYGON);
-        glVertex2f(-8, -6);
-        glVertex2f( 8, -6);
-        glVertex2f( 8,  6);
-        glVertex2f(-8,  6);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-8, -6);
+        rcVertex2f( 8, -6);
+        rcVertex2f( 8,  6);
+        rcVertex2f(-8,  6);
+    rcEnd();
 
     // --- TURRET TOP (hatch) ---
     setGlColor(Colors::CAR_GLASS); // reuse glass color as hatch highlight
-    glBegin(GL_POLYGON);
-        glVertex2f(-4, -2);
-        glVertex2f( 4, -2);
-        glVertex2f( 4,  2);
-        glVertex2f(-4,  2);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-4, -2);
+        rcVertex2f( 4, -2);
+        rcVertex2f( 4,  2);
+        rcVertex2f(-4,  2);
+    rcEnd();
+
+    // Turret outline
+    setGlColor(Colors::BLACK);
+    rcBegin(GL_LINE_LOOP);
+        rcVertex2f(-8, -6);
+        rcVertex2f( 8, -6);
+        rcVertex2f( 8,  6);
+        rcVertex2f(-8,  6);
+    rcEnd();
+}
+
+// Cannon barrel; origin at its root, 24 units in front of the turret pivot
+void drawTankBarrel() {
+    PROFILE_SCOPE("drawTankBarrel");
 
     // --- CANNON BARREL (points forward: negative Y) ---
     setGlColor(Colors::CAR_BUMPER);
-    glBegin(GL_POLYGON);
-        glVertex2f(-2, -24);   // connect near front of hull
-        glVertex2f( 2, -24);
-        glVertex2f( 2, -40);   // extend forward
-        glVertex2f(-2, -40);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-2,   0);
+        rcVertex2f( 2,   0);
+        rcVertex2f( 2, -16);
+        rcVertex2f(-2, -16);
+    rcEnd();
 
     // Barrel tip (muzzle)
     setGlColor(Colors::CAR_HEADLIGHT_ON);
-    glBegin(GL_POLYGON);
-        glVertex2f(-3, -40);
-        glVertex2f( 3, -40);
-        glVertex2f( 3, -43);
-        glVertex2f(-3, -43);
-    glEnd();
-
-    // --- OUTLINE WHOLE TANK ---
-    setGlColor(Colors::BLACK);
-    glLineWidth(1.0f);
-
-    // Hull outline
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(-14, -24);
-        glVertex2f( 14, -24);
-        glVertex2f( 14,  24);
-        glVertex2f(-14,  24);
-    glEnd();
-
-    // Tracks outline
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(-22, -26);
-        glVertex2f(-14, -26);
-        glVertex2f(-14,  26);
-        glVertex2f(-22,  26);
-    glEnd();
-
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(14, -26);
-        glVertex2f(22, -26);
-        glVertex2f(22,  26);
-        glVertex2f(14,  26);
-    glEnd();
-
-    // Turret outline
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(-8, -6);
-        glVertex2f( 8, -6);
-        glVertex2f( 8,  6);
-        glVertex2f(-8,  6);
-    glEnd();
+    rcBegin(GL_POLYGON);
+        rcVertex2f(-3, -16);
+        rcVertex2f( 3, -16);
+        rcVertex2f( 3, -19);
+        rcVertex2f(-3, -19);
+    rcEnd();
 
     // Barrel outline
-    glBegin(GL_LINE_LOOP);
-        glVertex2f(-2, -24);
-        glVertex2f( 2, -24);
-        glVertex2f( 2, -40);
-        glVertex2f(-2, -40);
-    glEnd();
+    setGlColor(Colors::BLACK);
+    rcBegin(GL_LINE_LOOP);
+        rcVertex2f(-2,   0);
+        rcVertex2f( 2,   0);
+        rcVertex2f( 2, -16);
+        rcVertex2f(-2, -16);
+    rcEnd();
 }
 
 
@@ -5,12 +5,15 @@
 // Required for GLfloat type definitions
 #include <GL/gl.h>
 
+// All drawing below is recorded into the render command buffer (render.h),
+// not sent to GL directly; drawScene() submits the frame.
+
 // --- Basic Utilities ---
 
 // Renders a single pixel at (x, y)
 void putPixel(int x, int y);
 
-// Utility to set OpenGL color using a GLfloat array (for consistency with Colors namespace)
+// Utility to set the draw color using a GLfloat array (for consistency with Colors namespace)
 void setGlColor(const GLfloat color[3]);
 void setGlColorAlpha(const GLfloat color[4]);
 
@@ -30,6 +33,11 @@ void drawCircleMidpoint(int xc, int yc, int r);
 void drawBackground();     // grass etc.
 void drawTrack();          // road, borders, lane, finish line
 void drawScenery();        // trees, stands, buildings
-void drawCarBody();        // detailed car in local coords
+void drawObstacles();      // walls, bunkers (level geometry)
+
+// Tank parts, each in its own local coords (hull -> turret -> barrel)
+void drawTankHull();
+void drawTankTurret();
+void drawTankBarrel();
 
 #endif // GRAPHICS_H
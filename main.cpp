@@ -1,22 +1,45 @@
 // main.cpp
 #include <GL/glut.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include "game.h"
+#include "simthread.h"
+#include "telemetry.h"
+#include "dynres.h"
+#include "stress.h"
+#include "profiler.h"
 
 // Define the desired frame delay for ~60 FPS
+// (rendering only: the simulation ticks on its own thread, see simthread.h)
 const int FRAME_DELAY_MS = 16; // 1000ms / 60 frames = 16.67ms (use 16)
 
 void displayCallback() {
+    // Frame interval for the telemetry log
+    using Clock = std::chrono::steady_clock;
+    static Clock::time_point lastFrame = Clock::now();
+    Clock::time_point now = Clock::now();
+    telemetryReportFrameTime((unsigned)std::chrono::duration_cast<std::chrono::microseconds>(now - lastFrame).count());
+    lastFrame = now;
+
     drawScene();
 }
 
 void timerCallback(int value) {
-    updateGame();
+    // One profiler frame on the GLUT thread = one redisplay
+    profilerBeginFrame();
+
     glutPostRedisplay();
     // Schedule the next call after FRAME_DELAY_MS
     glutTimerFunc(FRAME_DELAY_MS, timerCallback, 0);
 }
 
 int main(int argc, char** argv) {
+    // Stress benchmark mode (see stress.h); headless runs never open a window
+    StressConfig stress;
+    if (!stressParseArgs(argc, argv, stress)) return 1;
+    if (stress.enabled && stress.headless) return stressRunHeadless(stress, false);
+
     // 1. Initialization
     glutInit(&argc, argv);
 
@@ -28,15 +51,38 @@ int main(int argc, char** argv) {
     glutInitWindowSize(WIDTH, HEIGHT);
     glutCreateWindow("Battlefield Shooter: Tank Edition");
 
-    // Initialize game state, projection, and OpenGL settings
+    // Initialize projection and OpenGL settings
+    initGraphics();
+
+    // Stress run: ticks and frames back to back on this thread, no input
+    if (stress.enabled) {
+        glutDisplayFunc(stressDisplay);
+        glutReshapeFunc(dynresReshape);
+        stressBegin(stress);
+        glutMainLoop();
+        return 0;
+    }
+
+    // Split-screen: --players 2..4 (one keyboard, one viewport each)
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (!std::strcmp(argv[i], "--players")) setPlayerCount(std::atoi(argv[i + 1]));
+    }
+
+    // Gameplay telemetry (before initGame so the first wave is logged).
+    // Convert with: telemetry2csv telemetry.tlm > telemetry.csv
+    telemetryOpen("telemetry.tlm");
+
+    // Initialize game state
     initGame();
 
     // 2. Register Callbacks
     glutDisplayFunc(displayCallback);
+    glutReshapeFunc(dynresReshape);
     glutKeyboardFunc(handleKeyboard);
     glutSpecialFunc(handleSpecial);
 
-    // Start the game loop immediately (use 1ms delay)
+    // Start the simulation thread, then the render loop (use 1ms delay)
+    startSimThread();
     glutTimerFunc(1, timerCallback, 0);
 
     // 3. Enter Main Loop
@@ -0,0 +1,261 @@
+// obstacles.cpp
+#include <algorithm>
+
+#include "obstacles.h"
+
+// =====================================================
+// Storage
+// =====================================================
+
+// Flat BVH: internal nodes point at two children, leaves at a range of 'items'
+struct BvhNode {
+    AABB bounds;
+    int  left;    // child index, -1 for a leaf
+    int  right;
+    int  first;   // leaf only: first item
+    int  count;   // leaf only: number of items
+};
+
+constexpr int BVH_LEAF_SIZE   = 2;
+constexpr int BVH_STACK_DEPTH = 64;   // enough for any tree built from < 2^32 items
+
+static std::vector<Obstacle> obstacles;  // level order (for drawing)
+static std::vector<Obstacle> items;      // leaf order (for queries)
+static std::vector<BvhNode>  nodes;
+static unsigned              revision = 0;   // see obstacleRevision
+
+// =====================================================
+// Build
+// =====================================================
+
+static AABB merge(const AABB& a, const AABB& b) {
+    return {std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+            std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+}
+
+// Median split on the longest axis of the centroid bounds
+static int buildNode(int first, int count) {
+    int index = (int)nodes.size();
+    nodes.push_back({});
+
+    AABB bounds = items[first].box;
+    AABB centers = {bounds.minX + bounds.maxX, bounds.minY + bounds.maxY,
+                    bounds.minX + bounds.maxX, bounds.minY + bounds.maxY};
+    for (int i = first + 1; i < first + count; ++i) {
+        const AABB& b = items[i].box;
+        bounds = merge(bounds, b);
+        Fixed cx = b.minX + b.maxX, cy = b.minY + b.maxY;   // 2x centroid, only compared
+        centers = merge(centers, {cx, cy, cx, cy});
+    }
+    nodes[index].bounds = bounds;
+
+    if (count <= BVH_LEAF_SIZE) {
+        nodes[index].left  = -1;
+        nodes[index].right = -1;
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    bool splitX = (centers.maxX - centers.minX) >= (centers.maxY - centers.minY);
+    int half = count / 2;
+    std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+                     [splitX](const Obstacle& a, const Obstacle& b) {
+                         return splitX ? (a.box.minX + a.box.maxX) < (b.box.minX + b.box.maxX)
+                                       : (a.box.minY + a.box.maxY) < (b.box.minY + b.box.maxY);
+                     });
+
+    int left  = buildNode(first, half);
+    int right = buildNode(first + half, count - half);
+    nodes[index].left  = left;
+    nodes[index].right = right;
+    nodes[index].first = 0;
+    nodes[index].count = 0;
+    return index;
+}
+
+void setObstacles(const std::vector<Obstacle>& list) {
+    obstacles = list;
+    items = list;
+    ++revision;
+    nodes.clear();
+    nodes.reserve(list.size() * 2);
+    if (!items.empty()) buildNode(0, (int)items.size());
+}
+
+static AABB boxOf(int minX, int minY, int maxX, int maxY) {
+    return {Fixed::fromInt(minX), Fixed::fromInt(minY), Fixed::fromInt(maxX), Fixed::fromInt(maxY)};
+}
+
+void buildLevelObstacles() {
+    std::vector<Obstacle> level = {
+        // Pit building on the left (outside the battlefield, kept so every
+        // consumer of the level sees the same geometry)
+        {boxOf( 40, 180, 110, 320), OBSTACLE_BUILDING},
+
+        // Bunkers guarding the upper corners
+        {boxOf(200, 370, 240, 410), OBSTACLE_BUNKER},
+        {boxOf(560, 370, 600, 410), OBSTACLE_BUNKER},
+
+        // Side walls and a central barrier
+        {boxOf(250, 230, 262, 320), OBSTACLE_WALL},
+        {boxOf(538, 230, 550, 320), OBSTACLE_WALL},
+        {boxOf(340, 300, 460, 312), OBSTACLE_WALL},
+    };
+    setObstacles(level);
+}
+
+const std::vector<Obstacle>& levelObstacles() {
+    return obstacles;
+}
+
+unsigned obstacleRevision() {
+    return revision;
+}
+
+// =====================================================
+// Queries
+// =====================================================
+
+constexpr Fixed FX_ZERO = Fixed::fromInt(0);
+constexpr Fixed FX_ONE  = Fixed::fromInt(1);
+
+// Slab test of the segment p + t*d, t in [0, 1], against 'box' grown by
+// (ex, ey). On a hit 'tEnter' is the entry time (0 if p starts inside).
+// Slab times are divided directly (no reciprocal): exact to 1/65536 and
+// saturated for near-parallel segments.
+static bool segmentVsBox(Fixed px, Fixed py, Fixed dx, Fixed dy, const AABB& box,
+                         Fixed ex, Fixed ey, Fixed maxT, Fixed& tEnter, Fixed& nx, Fixed& ny) {
+    Fixed tMin = FX_ZERO, tMax = maxT;
+    Fixed normalX = FX_ZERO, normalY = FX_ZERO;
+
+    // X slab
+    if (dx == FX_ZERO) {
+        if (px < box.minX - ex || px > box.maxX + ex) return false;
+    } else {
+        Fixed t0 = (box.minX - ex - px) / dx;
+        Fixed t1 = (box.maxX + ex - px) / dx;
+        Fixed n  = -FX_ONE;
+        if (t0 > t1) { std::swap(t0, t1); n = FX_ONE; }
+        if (t0 > tMin) { tMin = t0; normalX = n; normalY = FX_ZERO; }
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+
+    // Y slab
+    if (dy == FX_ZERO) {
+        if (py < box.minY - ey || py > box.maxY + ey) return false;
+    } else {
+        Fixed t0 = (box.minY - ey - py) / dy;
+        Fixed t1 = (box.maxY + ey - py) / dy;
+        Fixed n  = -FX_ONE;
+        if (t0 > t1) { std::swap(t0, t1); n = FX_ONE; }
+        if (t0 > tMin) { tMin = t0; normalX = FX_ZERO; normalY = n; }
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+
+    tEnter = tMin;
+    nx = normalX;
+    ny = normalY;
+    return true;
+}
+
+// Closest hit along p + t*d against obstacles grown by (ex, ey).
+// 'skipInside' ignores obstacles the start point is already inside (sweeps).
+static bool castThroughTree(Fixed px, Fixed py, Fixed dx, Fixed dy, Fixed ex, Fixed ey,
+                            bool skipInside, ObstacleHit& hit) {
+    if (nodes.empty()) return false;
+
+    hit.t = FX_ONE;
+    bool found = false;
+    int stack[BVH_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const BvhNode& node = nodes[stack[--top]];
+        Fixed t, nx, ny;
+        if (!segmentVsBox(px, py, dx, dy, node.bounds, ex, ey, hit.t, t, nx, ny)) continue;
+
+        if (node.left >= 0) {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            if (!segmentVsBox(px, py, dx, dy, items[i].box, ex, ey, hit.t, t, nx, ny)) continue;
+            if (skipInside && nx == FX_ZERO && ny == FX_ZERO) continue;   // started inside
+            if (!found || t < hit.t) {
+                hit.t  = t;
+                hit.nx = nx;
+                hit.ny = ny;
+                found  = true;
+            }
+        }
+    }
+    return found;
+}
+
+bool raycastObstacles(Fixed x0, Fixed y0, Fixed x1, Fixed y1, ObstacleHit& hit) {
+    return castThroughTree(x0, y0, x1 - x0, y1 - y0, FX_ZERO, FX_ZERO, false, hit);
+}
+
+bool sweepObstacles(const AABB& box, Fixed dx, Fixed dy, ObstacleHit& hit) {
+    // Minkowski sum: sweeping the box == casting its center against grown obstacles
+    Fixed ex = Fixed::fromRaw((box.maxX.raw - box.minX.raw) / 2);
+    Fixed ey = Fixed::fromRaw((box.maxY.raw - box.minY.raw) / 2);
+    Fixed cx = Fixed::fromRaw(box.minX.raw + ex.raw);
+    Fixed cy = Fixed::fromRaw(box.minY.raw + ey.raw);
+    return castThroughTree(cx, cy, dx, dy, ex, ey, true, hit);
+}
+
+static bool overlaps(const AABB& a, const AABB& b) {
+    return a.minX < b.maxX && a.maxX > b.minX && a.minY < b.maxY && a.maxY > b.minY;
+}
+
+bool overlapsObstacle(const AABB& box) {
+    if (nodes.empty()) return false;
+
+    int stack[BVH_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const BvhNode& node = nodes[stack[--top]];
+        if (!overlaps(box, node.bounds)) continue;
+
+        if (node.left >= 0) {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+            continue;
+        }
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            if (overlaps(box, items[i].box)) return true;
+        }
+    }
+    return false;
+}
+
+void queryObstacles(const AABB& box, std::vector<AABB>& out) {
+    if (nodes.empty()) return;
+
+    int stack[BVH_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const BvhNode& node = nodes[stack[--top]];
+        if (!overlaps(box, node.bounds)) continue;
+
+        if (node.left >= 0) {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+            continue;
+        }
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            if (overlaps(box, items[i].box)) out.push_back(items[i].box);
+        }
+    }
+}
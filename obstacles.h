@@ -0,0 +1,67 @@
+// obstacles.h
+#ifndef OBSTACLES_H
+#define OBSTACLES_H
+
+#include <vector>
+
+#include "fixed.h"   // Fixed (sim coordinates)
+
+// Static level geometry (walls, bunkers, the pit building) stored in a
+// bounding-volume hierarchy that is built once per level. All queries walk the
+// tree, so they stay logarithmic in the number of obstacles.
+//
+// The geometry is immutable after setObstacles(): the sim thread queries it
+// and the GLUT thread draws it without any locking. Coordinates are Fixed
+// like the rest of the sim state, so query results are bit-exact.
+
+struct AABB {
+    Fixed minX, minY;
+    Fixed maxX, maxY;
+};
+
+enum ObstacleKind {
+    OBSTACLE_WALL,
+    OBSTACLE_BUNKER,
+    OBSTACLE_BUILDING   // pit building, drawn by drawScenery()
+};
+
+struct Obstacle {
+    AABB         box;
+    ObstacleKind kind;
+};
+
+// Result of a ray / sweep query
+struct ObstacleHit {
+    Fixed t;        // fraction of the segment / move in [0, 1]
+    Fixed nx, ny;   // surface normal at the hit (axis aligned, -1 / 0 / 1)
+};
+
+// --- Level setup (Defined in obstacles.cpp) ---
+
+// Replaces the obstacle set and rebuilds the tree (not during a tick)
+void setObstacles(const std::vector<Obstacle>& list);
+
+// Default battlefield layout
+void buildLevelObstacles();
+
+const std::vector<Obstacle>& levelObstacles();
+
+// Bumped by every setObstacles(): drawn copies of the level (baked static
+// scene) compare it to know when to rebuild
+unsigned obstacleRevision();
+
+// --- Queries ---
+
+// First obstacle hit by the segment (x0,y0) -> (x1,y1)
+bool raycastObstacles(Fixed x0, Fixed y0, Fixed x1, Fixed y1, ObstacleHit& hit);
+
+// First obstacle hit when 'box' moves by (dx, dy) (swept AABB)
+bool sweepObstacles(const AABB& box, Fixed dx, Fixed dy, ObstacleHit& hit);
+
+// True if 'box' overlaps any obstacle
+bool overlapsObstacle(const AABB& box);
+
+// Appends the box of every obstacle overlapping 'box' to 'out'
+void queryObstacles(const AABB& box, std::vector<AABB>& out);
+
+#endif // OBSTACLES_H
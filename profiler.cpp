@@ -0,0 +1,362 @@
+// profiler.cpp
+#ifdef ENABLE_PROFILER
+
+#include <GL/glut.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#define PROFILER_NO_GL_HOOKS   // the overlay must not count its own GL calls
+#include "game.h"      // WIDTH, HEIGHT
+#include "render.h"    // renderStats
+#include "glstate.h"   // gsStats, gsInvalidate
+#include "profiler.h"
+
+// ---- Storage (fixed size, nothing is allocated while profiling) ----
+
+constexpr int PROF_MAX_FRAMES = 240;   // ~4 seconds of history at 60 FPS
+constexpr int PROF_MAX_ZONES  = 32;    // zones recorded per frame
+
+struct ZoneRecord {
+    const char* name;
+    double startUs;
+    double durUs;
+    int    depth;
+};
+
+struct FrameRecord {
+    double     startUs;
+    double     durUs;
+    int        glCalls;
+    int        vertices;
+    int        zoneCount;
+    ZoneRecord zones[PROF_MAX_ZONES];
+};
+
+static_assert(std::is_trivially_copyable<FrameRecord>::value, "frames are copied word by word");
+constexpr int PROF_FRAME_WORDS = (sizeof(FrameRecord) + 7) / 8;
+
+// One lane per profiled thread. A frame is recorded in 'current' by the
+// lane's thread only, then published to the ring of completed frames, which
+// any thread reads with copyFrame. As in the event bus (events.h), the ring
+// stores relaxed atomic words and a sequence number per slot (odd while the
+// slot is written), so a reader racing with the writer gets a torn copy,
+// sees the changed sequence number and drops it, without undefined behaviour.
+struct ProfLane {
+    std::atomic<const char*> name{nullptr};   // set when the lane's thread registers
+    FrameRecord              current;
+    std::atomic<uint64_t>    frames[PROF_MAX_FRAMES][PROF_FRAME_WORDS];
+    std::atomic<unsigned>    seq[PROF_MAX_FRAMES];
+    std::atomic<int>         head{0};   // slot the next completed frame goes to
+    std::atomic<int>         done{0};   // completed frames (saturates at PROF_MAX_FRAMES)
+    bool                     frameOpen = false;
+    int                      zoneDepth = 0;
+};
+
+constexpr int PROF_MAX_LANES = 3;
+
+int profGlCalls  = 0;
+int profVertices = 0;
+
+static ProfLane lanes[PROF_MAX_LANES];         // lanes[0] = GLUT main thread
+static std::atomic<int> laneCount{1};
+static thread_local ProfLane* lane = &lanes[0];
+static bool overlayOn = false;
+
+using ProfClock = std::chrono::steady_clock;
+static const ProfClock::time_point profEpoch = ProfClock::now();
+
+static double nowUs() {
+    return std::chrono::duration<double, std::micro>(ProfClock::now() - profEpoch).count();
+}
+
+// Copies completed frame 'age' frames ago (0 = most recent) of any lane;
+// false if its slot was rewritten meanwhile, so a copy never mixes two frames
+static bool copyFrame(const ProfLane& l, int age, FrameRecord& out) {
+    int slot = (l.head.load(std::memory_order_acquire) - 1 - age + PROF_MAX_FRAMES) % PROF_MAX_FRAMES;
+    unsigned seq = l.seq[slot].load(std::memory_order_acquire);
+    if (seq & 1) return false;
+
+    uint64_t words[PROF_FRAME_WORDS];
+    for (int i = 0; i < PROF_FRAME_WORDS; ++i) words[i] = l.frames[slot][i].load(std::memory_order_relaxed);
+
+    // Seqlock read side: the copy is valid only if the slot did not change meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (l.seq[slot].load(std::memory_order_relaxed) != seq) return false;
+
+    std::memcpy(&out, words, sizeof(FrameRecord));
+    return true;
+}
+
+// Lane's thread: appends the finished 'current' frame to the ring
+static void publishFrame(ProfLane& l) {
+    uint64_t words[PROF_FRAME_WORDS] = {};
+    std::memcpy(words, &l.current, sizeof(FrameRecord));
+
+    // Odd before the payload is touched (seqlock write side)
+    int head = l.head.load(std::memory_order_relaxed);
+    l.seq[head].fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < PROF_FRAME_WORDS; ++i) l.frames[head][i].store(words[i], std::memory_order_relaxed);
+    l.seq[head].fetch_add(1, std::memory_order_release);
+
+    l.head.store((head + 1) % PROF_MAX_FRAMES, std::memory_order_release);
+    if (l.done.load(std::memory_order_relaxed) < PROF_MAX_FRAMES) {
+        l.done.fetch_add(1, std::memory_order_release);
+    }
+}
+
+// =====================================================
+// Recording
+// =====================================================
+
+void profilerRegisterThread(const char* name) {
+    int idx = laneCount.fetch_add(1);
+    if (idx >= PROF_MAX_LANES) return; // out of lanes: thread keeps sharing lane 0's name
+    lanes[idx].name.store(name, std::memory_order_release);
+    lane = &lanes[idx];
+}
+
+void profilerBeginFrame() {
+    ProfLane& l = *lane;
+    double now = nowUs();
+    bool glThread = (&l == &lanes[0]);   // GL is only ever called from the GLUT thread
+    FrameRecord& f = l.current;
+
+    if (l.frameOpen) {
+        f.durUs    = now - f.startUs;
+        f.glCalls  = glThread ? profGlCalls : 0;
+        f.vertices = glThread ? profVertices : 0;
+        publishFrame(l);
+    }
+
+    f.startUs   = now;
+    f.durUs     = 0.0;
+    f.zoneCount = 0;
+    if (glThread) {
+        profGlCalls  = 0;
+        profVertices = 0;
+    }
+    l.zoneDepth = 0;
+    l.frameOpen = true;
+}
+
+int profilerZoneBegin(const char* name) {
+    ProfLane& l = *lane;
+    ++l.zoneDepth;
+    if (!l.frameOpen) return -1;
+
+    FrameRecord& f = l.current;
+    if (f.zoneCount >= PROF_MAX_ZONES) return -1; // drop, frame is full
+
+    ZoneRecord& z = f.zones[f.zoneCount];
+    z.name    = name;
+    z.depth   = l.zoneDepth - 1;
+    z.durUs   = 0.0;
+    z.startUs = nowUs();
+    return f.zoneCount++;
+}
+
+void profilerZoneEnd(int zone) {
+    ProfLane& l = *lane;
+    --l.zoneDepth;
+    if (zone < 0) return;
+
+    ZoneRecord& z = l.current.zones[zone];
+    z.durUs = nowUs() - z.startUs;
+}
+
+// =====================================================
+// Overlay
+// =====================================================
+
+void profilerToggleOverlay() {
+    overlayOn = !overlayOn;
+}
+
+// Stable color per zone name so the graph segments are easy to follow
+static void zoneColor(const char* name) {
+    static const GLfloat palette[][3] = {
+        {0.95f, 0.35f, 0.35f}, {0.35f, 0.85f, 0.35f}, {0.35f, 0.55f, 0.95f},
+        {0.95f, 0.85f, 0.30f}, {0.85f, 0.40f, 0.90f}, {0.30f, 0.90f, 0.90f},
+        {0.95f, 0.60f, 0.25f}, {0.70f, 0.70f, 0.70f}
+    };
+    unsigned h = 0;
+    for (const char* c = name; *c; ++c) h = h * 31u + (unsigned char)*c;
+    glColor3fv(palette[h % (sizeof(palette) / sizeof(palette[0]))]);
+}
+
+static void overlayText(float x, float y, const char* text) {
+    glRasterPos2f(x, y);
+    while (*text) {
+        glutBitmapCharacter(GLUT_BITMAP_8_BY_13, *text);
+        ++text;
+    }
+}
+
+void drawProfilerOverlay() {
+    const ProfLane& main = lanes[0];
+    int framesDone = main.done.load(std::memory_order_acquire);
+    if (!overlayOn || framesDone == 0) return;
+
+    constexpr float PANEL_X    = WIDTH - 250.0f;
+    constexpr float PANEL_Y    = 10.0f;
+    constexpr float PANEL_W    = 240.0f;
+    constexpr float PANEL_H    = 230.0f;
+    constexpr float GRAPH_H    = 100.0f;
+    constexpr float MS_TO_PX   = GRAPH_H / 33.3f;   // graph top = 2 frames at 60 FPS
+    constexpr int   BARS       = 120;
+    constexpr float BAR_W      = PANEL_W / BARS;
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    GLboolean blendWasOn = glIsEnabled(GL_BLEND);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Background panel
+    glColor4f(0.0f, 0.0f, 0.0f, 0.65f);
+    glBegin(GL_QUADS);
+        glVertex2f(PANEL_X, PANEL_Y);
+        glVertex2f(PANEL_X + PANEL_W, PANEL_Y);
+        glVertex2f(PANEL_X + PANEL_W, PANEL_Y + PANEL_H);
+        glVertex2f(PANEL_X, PANEL_Y + PANEL_H);
+    glEnd();
+
+    // Frame-time graph: one bar per frame, newest on the right, split by top-level zone
+    glBegin(GL_QUADS);
+    int bars = framesDone < BARS ? framesDone : BARS;
+    FrameRecord f;   // copies of this thread's own frames: never torn
+    for (int age = 0; age < bars; ++age) {
+        if (!copyFrame(main, age, f)) continue;
+        float x0 = PANEL_X + PANEL_W - (age + 1) * BAR_W;
+        float x1 = x0 + BAR_W;
+        float y  = PANEL_Y;
+        double zonedUs = 0.0;
+
+        for (int z = 0; z < f.zoneCount; ++z) {
+            if (f.zones[z].depth != 0) continue;
+            float h = (float)(f.zones[z].durUs / 1000.0) * MS_TO_PX;
+            zoneColor(f.zones[z].name);
+            glVertex2f(x0, y);     glVertex2f(x1, y);
+            glVertex2f(x1, y + h); glVertex2f(x0, y + h);
+            y += h;
+            zonedUs += f.zones[z].durUs;
+        }
+
+        // Remainder of the frame not covered by any zone (idle / GLUT)
+        float rest = (float)((f.durUs - zonedUs) / 1000.0) * MS_TO_PX;
+        if (rest > 0.0f) {
+            glColor4f(0.4f, 0.4f, 0.4f, 0.5f);
+            glVertex2f(x0, y);        glVertex2f(x1, y);
+            glVertex2f(x1, y + rest); glVertex2f(x0, y + rest);
+        }
+    }
+    glEnd();
+
+    // 60 FPS budget line
+    glColor3f(1.0f, 1.0f, 1.0f);
+    glBegin(GL_LINES);
+        glVertex2f(PANEL_X, PANEL_Y + 16.7f * MS_TO_PX);
+        glVertex2f(PANEL_X + PANEL_W, PANEL_Y + 16.7f * MS_TO_PX);
+    glEnd();
+
+    // Numbers for the most recent frame
+    FrameRecord last;
+    copyFrame(main, 0, last);
+    char buffer[96];
+    float ty = PANEL_Y + PANEL_H - 16.0f;
+
+    glColor3f(1.0f, 1.0f, 1.0f);
+    std::snprintf(buffer, sizeof(buffer), "frame %.2f ms", last.durUs / 1000.0);
+    overlayText(PANEL_X + 6.0f, ty, buffer);
+    ty -= 14.0f;
+    std::snprintf(buffer, sizeof(buffer), "GL calls %d  verts %d", last.glCalls, last.vertices);
+    overlayText(PANEL_X + 6.0f, ty, buffer);
+    ty -= 14.0f;
+    const RenderStats& rs = renderStats();
+    std::snprintf(buffer, sizeof(buffer), "cmds %d  batches %d  culled %d  arena %zuK",
+                  rs.commands, rs.batches, rs.culled, rs.arenaUsed / 1024);
+    overlayText(PANEL_X + 6.0f, ty, buffer);
+    ty -= 14.0f;
+    const GlStateStats& gs = gsStats();
+    std::snprintf(buffer, sizeof(buffer), "saved: state %d/%d  draws %d",
+                  gs.skipped, gs.issued + gs.skipped, rs.commands - rs.batches);
+    overlayText(PANEL_X + 6.0f, ty, buffer);
+    ty -= 14.0f;
+
+    // Zones of the last frame of every lane (GLUT thread first, then sim ...)
+    int lanesUsed = laneCount.load() < PROF_MAX_LANES ? laneCount.load() : PROF_MAX_LANES;
+    FrameRecord lf;   // copy: the sim thread may be reusing the slot
+    for (int li = 0; li < lanesUsed; ++li) {
+        const ProfLane& l = lanes[li];
+        if (l.done.load(std::memory_order_acquire) == 0) continue;
+        if (!copyFrame(l, 0, lf)) continue;   // being overwritten: skip this lane this frame
+
+        for (int z = 0; z < lf.zoneCount && ty > PANEL_Y + GRAPH_H + 4.0f; ++z) {
+            const ZoneRecord& zr = lf.zones[z];
+            zoneColor(zr.name);
+            std::snprintf(buffer, sizeof(buffer), "%*s%s %.3f", zr.depth * 2, "", zr.name, zr.durUs / 1000.0);
+            overlayText(PANEL_X + 6.0f, ty, buffer);
+            ty -= 14.0f;
+        }
+    }
+
+    if (!blendWasOn) glDisable(GL_BLEND);
+    gsInvalidate();   // color and matrices were set behind the cache's back
+}
+
+// =====================================================
+// Chrome trace export
+// =====================================================
+
+// Lanes counted in laneCount may not have stored their name yet
+static const char* laneName(int li) {
+    if (li == 0) return "GLUT main";
+    const char* name = lanes[li].name.load(std::memory_order_acquire);
+    return name ? name : "thread";
+}
+
+bool profilerExportTrace(const char* path) {
+    std::FILE* out = std::fopen(path, "w");
+    if (!out) return false;
+
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"TankGame\"}}");
+
+    int lanesUsed = laneCount.load() < PROF_MAX_LANES ? laneCount.load() : PROF_MAX_LANES;
+    for (int li = 0; li < lanesUsed; ++li) {
+        const ProfLane& l = lanes[li];
+        int tid = li + 1;
+        std::fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                          "\"args\":{\"name\":\"%s\"}}", tid, laneName(li));
+
+        // Oldest first so the timeline reads left to right
+        int frames = l.done.load(std::memory_order_acquire);
+        FrameRecord f;
+        for (int age = frames - 1; age >= 0; --age) {
+            if (!copyFrame(l, age, f)) continue;   // reused by the lane's thread meanwhile
+
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                              "\"ts\":%.3f,\"dur\":%.3f}", li == 0 ? "frame" : "tick", tid, f.startUs, f.durUs);
+            for (int z = 0; z < f.zoneCount; ++z) {
+                const ZoneRecord& zr = f.zones[z];
+                std::fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                  "\"ts\":%.3f,\"dur\":%.3f}", zr.name, tid, zr.startUs, zr.durUs);
+            }
+            if (li == 0) {
+                std::fprintf(out, ",\n{\"name\":\"GL\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+                                  "\"args\":{\"calls\":%d,\"vertices\":%d}}", f.startUs, f.glCalls, f.vertices);
+            }
+        }
+    }
+
+    std::fprintf(out, "\n]}\n");
+    return std::fclose(out) == 0;
+}
+
+#endif // ENABLE_PROFILER
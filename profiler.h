@@ -0,0 +1,151 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Built-in frame profiler.
+//
+// Everything here is compiled out unless ENABLE_PROFILER is defined (the Debug
+// target in CarRacing.cbp defines it). When enabled it provides:
+//  - PROFILE_SCOPE("name"): scoped wall-clock timer, nested zones allowed
+//  - per-frame GL call / vertex counters (see "GL call counting" below)
+//  - an on-screen overlay graph of the last frames (toggle with P)
+//  - export of the recorded frames as Chrome trace_event JSON (T key),
+//    viewable in chrome://tracing or https://ui.perfetto.dev
+//
+// IMPORTANT: include this header AFTER <GL/glut.h> / "graphics.h", because
+// with the profiler enabled it redirects the GL entry points used by the draw
+// code to counting wrappers.
+
+#include <GL/gl.h>
+
+#ifdef ENABLE_PROFILER
+
+// --- Frame / zone API (Defined in profiler.cpp) ---
+
+// Closes the calling thread's previous frame (if any) and starts a new one.
+// Each thread records into its own lane; the GLUT thread uses the first lane.
+void profilerBeginFrame();
+
+// Gives the calling thread its own lane (call once, at thread start)
+void profilerRegisterThread(const char* name);
+
+void profilerToggleOverlay();
+void drawProfilerOverlay();
+
+// Writes all recorded frames to 'path'; returns false if the file could not be written
+bool profilerExportTrace(const char* path);
+
+// Zone bookkeeping used by ProfileScope
+int  profilerZoneBegin(const char* name);
+void profilerZoneEnd(int zone);
+
+// Per-frame counters (plain ints: GL is only called from the GLUT thread)
+extern int profGlCalls;
+extern int profVertices;
+
+// RAII timer that records one zone into the current frame
+struct ProfileScope {
+    int zone;
+    explicit ProfileScope(const char* name) : zone(profilerZoneBegin(name)) {}
+    ~ProfileScope() { profilerZoneEnd(zone); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name)        ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+// --- GL call counting ---
+// Each wrapper bumps the counters and forwards to the real entry point. The
+// wrappers are defined before the macros so that they still reach real GL.
+// profiler.cpp defines PROFILER_NO_GL_HOOKS so the overlay does not count itself.
+
+inline void profBegin(GLenum mode)                        { ++profGlCalls; glBegin(mode); }
+inline void profEnd()                                     { ++profGlCalls; glEnd(); }
+inline void profVertex2i(GLint x, GLint y)                { ++profGlCalls; ++profVertices; glVertex2i(x, y); }
+inline void profVertex2f(GLfloat x, GLfloat y)            { ++profGlCalls; ++profVertices; glVertex2f(x, y); }
+inline void profColor3f(GLfloat r, GLfloat g, GLfloat b)  { ++profGlCalls; glColor3f(r, g, b); }
+inline void profColor3fv(const GLfloat* c)                { ++profGlCalls; glColor3fv(c); }
+inline void profColor4fv(const GLfloat* c)                { ++profGlCalls; glColor4fv(c); }
+inline void profLineWidth(GLfloat w)                      { ++profGlCalls; glLineWidth(w); }
+inline void profEnable(GLenum cap)                        { ++profGlCalls; glEnable(cap); }
+inline void profDisable(GLenum cap)                       { ++profGlCalls; glDisable(cap); }
+inline void profBlendFunc(GLenum s, GLenum d)             { ++profGlCalls; glBlendFunc(s, d); }
+inline void profPushMatrix()                              { ++profGlCalls; glPushMatrix(); }
+inline void profPopMatrix()                               { ++profGlCalls; glPopMatrix(); }
+inline void profTranslatef(GLfloat x, GLfloat y, GLfloat z)          { ++profGlCalls; glTranslatef(x, y, z); }
+inline void profRotatef(GLfloat a, GLfloat x, GLfloat y, GLfloat z)  { ++profGlCalls; glRotatef(a, x, y, z); }
+inline void profScalef(GLfloat x, GLfloat y, GLfloat z)              { ++profGlCalls; glScalef(x, y, z); }
+inline void profMultMatrixf(const GLfloat* m)             { ++profGlCalls; glMultMatrixf(m); }
+inline void profRasterPos2f(GLfloat x, GLfloat y)         { ++profGlCalls; glRasterPos2f(x, y); }
+inline void profDrawArrays(GLenum mode, GLint first, GLsizei count)  { ++profGlCalls; profVertices += count; glDrawArrays(mode, first, count); }
+inline void profVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid* p) { ++profGlCalls; glVertexPointer(size, type, stride, p); }
+inline void profEnableClientState(GLenum a)               { ++profGlCalls; glEnableClientState(a); }
+inline void profDisableClientState(GLenum a)              { ++profGlCalls; glDisableClientState(a); }
+inline void profViewport(GLint x, GLint y, GLsizei w, GLsizei h)   { ++profGlCalls; glViewport(x, y, w, h); }
+inline void profCopyTexSubImage2D(GLenum target, GLint level, GLint dx, GLint dy, GLint x, GLint y, GLsizei w, GLsizei h) {
+    ++profGlCalls;
+    glCopyTexSubImage2D(target, level, dx, dy, x, y, w, h);
+}
+inline void profLoadMatrixf(const GLfloat* m)             { ++profGlCalls; glLoadMatrixf(m); }
+inline void profLoadIdentity()                            { ++profGlCalls; glLoadIdentity(); }
+inline void profMatrixMode(GLenum mode)                   { ++profGlCalls; glMatrixMode(mode); }
+inline void profTexCoord2f(GLfloat s, GLfloat t)          { ++profGlCalls; glTexCoord2f(s, t); }
+inline void profBindTexture(GLenum target, GLuint tex)    { ++profGlCalls; glBindTexture(target, tex); }
+inline void profPixelStorei(GLenum name, GLint value)     { ++profGlCalls; glPixelStorei(name, value); }
+inline void profCallList(GLuint list)                     { ++profGlCalls; glCallList(list); }
+inline void profTexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei w, GLsizei h,
+                              GLenum format, GLenum type, const GLvoid* pixels) {
+    ++profGlCalls;
+    glTexSubImage2D(target, level, x, y, w, h, format, type, pixels);
+}
+
+#ifndef PROFILER_NO_GL_HOOKS
+#define glBegin       profBegin
+#define glEnd         profEnd
+#define glVertex2i    profVertex2i
+#define glVertex2f    profVertex2f
+#define glColor3f     profColor3f
+#define glColor3fv    profColor3fv
+#define glColor4fv    profColor4fv
+#define glLineWidth   profLineWidth
+#define glEnable      profEnable
+#define glDisable     profDisable
+#define glBlendFunc   profBlendFunc
+#define glPushMatrix  profPushMatrix
+#define glPopMatrix   profPopMatrix
+#define glTranslatef  profTranslatef
+#define glRotatef     profRotatef
+#define glScalef      profScalef
+#define glMultMatrixf profMultMatrixf
+#define glRasterPos2f profRasterPos2f
+#define glDrawArrays  profDrawArrays
+#define glVertexPointer       profVertexPointer
+#define glEnableClientState   profEnableClientState
+#define glDisableClientState  profDisableClientState
+#define glViewport            profViewport
+#define glCopyTexSubImage2D   profCopyTexSubImage2D
+#define glLoadMatrixf         profLoadMatrixf
+#define glLoadIdentity        profLoadIdentity
+#define glMatrixMode          profMatrixMode
+#define glTexCoord2f          profTexCoord2f
+#define glBindTexture         profBindTexture
+#define glTexSubImage2D       profTexSubImage2D
+#define glPixelStorei         profPixelStorei
+#define glCallList            profCallList
+#endif
+
+#else // !ENABLE_PROFILER
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+inline void profilerBeginFrame() {}
+inline void profilerRegisterThread(const char*) {}
+inline void profilerToggleOverlay() {}
+inline void drawProfilerOverlay() {}
+inline bool profilerExportTrace(const char*) { return false; }
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,510 @@
+// render.cpp
+#include <GL/glut.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "glstate.h"
+#include "render.h"
+#include "profiler.h"  // must stay last: hooks GL calls when profiling
+
+// =====================================================
+// Arena
+// =====================================================
+
+constexpr size_t ARENA_INITIAL_BYTES = 1 << 20;   // 1 MB, a frame uses ~250 KB
+
+void* FrameArena::alloc(size_t bytes, size_t align) {
+    size_t start = (top + align - 1) & ~(align - 1);
+    if (start + bytes > capacity) {
+        overflow += bytes;
+        return nullptr;
+    }
+    top = start + bytes;
+    return base + start;
+}
+
+void FrameArena::reset() {
+    if (overflow > 0 || !base) {
+        size_t wanted = std::max(ARENA_INITIAL_BYTES, (capacity + overflow) * 2);
+        std::free(base);
+        base = static_cast<unsigned char*>(std::malloc(wanted));
+        capacity = base ? wanted : 0;
+    }
+    top = 0;
+    overflow = 0;
+}
+
+// =====================================================
+// Recording state
+// =====================================================
+
+constexpr int MATRIX_STACK_DEPTH = 16;
+
+// 2D affine transform: x' = a*x + c*y + e,  y' = b*x + d*y + f
+struct Affine2D {
+    GLfloat a, b, c, d, e, f;
+};
+
+static const Affine2D IDENTITY = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+
+static FrameArena     arena;
+static RenderCommand* firstCmd = nullptr;
+static RenderCommand* lastCmd  = nullptr;
+static RenderStats    stats;
+
+static Affine2D   matrixStack[MATRIX_STACK_DEPTH];
+static int        matrixTop = 0;
+
+static RenderLayer curLayer     = LAYER_GROUND;
+static GLfloat    curColor[4]  = {1.0f, 1.0f, 1.0f, 1.0f};
+static GLfloat    curLineWidth = 1.0f;
+static bool       curBlend     = false;
+static unsigned   curGroup     = 0;
+static bool       unordered    = false;
+
+// Current rcBegin block
+static GLenum        blockMode  = 0;
+static RenderVertex* blockVerts = nullptr;
+static int           blockCount = 0;
+static bool          blockLost  = false;
+
+static unsigned packColor(const GLfloat c[4]) {
+    auto q = [](GLfloat v) { return (unsigned)(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f); };
+    return (q(c[0]) << 24) | (q(c[1]) << 16) | (q(c[2]) << 8) | q(c[3]);
+}
+
+static RenderCommand* newCommand(RenderPrim prim) {
+    RenderCommand* cmd = arena.allocArray<RenderCommand>(1);
+    if (!cmd) return nullptr;
+
+    cmd->next      = nullptr;
+    cmd->seq       = (unsigned)stats.commands++;
+    cmd->group     = unordered ? curGroup : curGroup++;
+    cmd->layer     = (unsigned char)curLayer;
+    cmd->prim      = (unsigned char)prim;
+    cmd->blend     = curBlend;
+    cmd->lineWidth = curLineWidth;
+    std::memcpy(cmd->color, curColor, sizeof(curColor));
+    cmd->colorKey  = packColor(curColor);
+    cmd->verts     = nullptr;
+    cmd->count     = 0;
+    cmd->lo        = {0.0f, 0.0f};
+    cmd->hi        = {0.0f, 0.0f};
+    cmd->font      = nullptr;
+    cmd->text      = nullptr;
+
+    if (lastCmd) lastCmd->next = cmd;
+    else         firstCmd = cmd;
+    lastCmd = cmd;
+    return cmd;
+}
+
+// =====================================================
+// Frame lifecycle
+// =====================================================
+
+void renderBeginFrame() {
+    arena.reset();
+    firstCmd = lastCmd = nullptr;
+    std::memset(&stats, 0, sizeof(stats));
+
+    matrixTop = 0;
+    matrixStack[0] = IDENTITY;
+    curLayer     = LAYER_GROUND;
+    curColor[0] = curColor[1] = curColor[2] = curColor[3] = 1.0f;
+    curLineWidth = 1.0f;
+    curBlend     = false;
+    curGroup     = 0;
+    unordered    = false;
+    blockMode    = 0;
+}
+
+const RenderStats& renderStats() {
+    stats.arenaUsed     = arena.top;
+    stats.arenaCapacity = arena.capacity;
+    return stats;
+}
+
+// --- State ---
+
+void rcLayer(RenderLayer layer) { curLayer = layer; }
+
+void rcColor3f(GLfloat r, GLfloat g, GLfloat b) {
+    curColor[0] = r; curColor[1] = g; curColor[2] = b; curColor[3] = 1.0f;
+}
+
+void rcColor3fv(const GLfloat color[3]) { rcColor3f(color[0], color[1], color[2]); }
+
+void rcColor4fv(const GLfloat color[4]) { std::memcpy(curColor, color, sizeof(curColor)); }
+
+void rcLineWidth(GLfloat width) { curLineWidth = width; }
+
+void rcBlend(bool enabled) { curBlend = enabled; }
+
+void rcBeginUnordered() {
+    unordered = true;
+}
+
+void rcEndUnordered() {
+    unordered = false;
+    ++curGroup;
+}
+
+// --- Transforms ---
+
+static void multiply(const Affine2D& m) {
+    Affine2D& t = matrixStack[matrixTop];
+    Affine2D r;
+    r.a = t.a * m.a + t.c * m.b;
+    r.b = t.b * m.a + t.d * m.b;
+    r.c = t.a * m.c + t.c * m.d;
+    r.d = t.b * m.c + t.d * m.d;
+    r.e = t.a * m.e + t.c * m.f + t.e;
+    r.f = t.b * m.e + t.d * m.f + t.f;
+    t = r;
+}
+
+void rcLoadIdentity() { matrixStack[matrixTop] = IDENTITY; }
+
+void rcPushMatrix() {
+    if (matrixTop + 1 < MATRIX_STACK_DEPTH) {
+        matrixStack[matrixTop + 1] = matrixStack[matrixTop];
+        ++matrixTop;
+    }
+}
+
+void rcPopMatrix() {
+    if (matrixTop > 0) --matrixTop;
+}
+
+void rcTranslatef(GLfloat x, GLfloat y) { multiply({1.0f, 0.0f, 0.0f, 1.0f, x, y}); }
+
+void rcRotatef(GLfloat degrees) {
+    GLfloat rad = degrees * 3.14159265f / 180.0f;
+    GLfloat c = std::cos(rad), s = std::sin(rad);
+    multiply({c, s, -s, c, 0.0f, 0.0f});
+}
+
+void rcScalef(GLfloat sx, GLfloat sy) { multiply({sx, 0.0f, 0.0f, sy, 0.0f, 0.0f}); }
+
+void rcMultMatrixf(const GLfloat m[16]) { multiply({m[0], m[1], m[4], m[5], m[12], m[13]}); }
+
+// --- Geometry ---
+
+// Bounds of a command's vertices; lines and points reach half their width
+// past them (views are drawn 1:1, so pixels are world units)
+static void setBounds(RenderCommand& cmd) {
+    RenderVertex lo = cmd.verts[0], hi = cmd.verts[0];
+    for (int i = 1; i < cmd.count; ++i) {
+        lo.x = std::min(lo.x, cmd.verts[i].x); hi.x = std::max(hi.x, cmd.verts[i].x);
+        lo.y = std::min(lo.y, cmd.verts[i].y); hi.y = std::max(hi.y, cmd.verts[i].y);
+    }
+    if (cmd.prim == PRIM_LINES || cmd.prim == PRIM_POINTS) {
+        GLfloat pad = cmd.lineWidth * 0.5f + 1.0f;
+        lo.x -= pad; lo.y -= pad;
+        hi.x += pad; hi.y += pad;
+    }
+    cmd.lo = lo;
+    cmd.hi = hi;
+}
+
+void rcBegin(GLenum mode) {
+    blockMode  = mode;
+    blockCount = 0;
+    blockLost  = false;
+    // Vertices of one block are bumped contiguously right after this point
+    blockVerts = reinterpret_cast<RenderVertex*>(arena.base + ((arena.top + alignof(RenderVertex) - 1) & ~(alignof(RenderVertex) - 1)));
+}
+
+void rcVertex2f(GLfloat x, GLfloat y) {
+    RenderVertex* v = arena.allocArray<RenderVertex>(1);
+    if (!v) { blockLost = true; return; }
+
+    const Affine2D& m = matrixStack[matrixTop];
+    v->x = m.a * x + m.c * y + m.e;
+    v->y = m.b * x + m.d * y + m.f;
+    ++blockCount;
+}
+
+void rcEnd() {
+    const RenderVertex* in = blockVerts;
+    int n = blockCount;
+    GLenum mode = blockMode;
+    blockMode = 0;
+    if (blockLost || n == 0) return;
+
+    RenderPrim prim;
+    RenderVertex* out = nullptr;
+    int outCount = 0;
+
+    switch (mode) {
+    case GL_POINTS:
+        prim = PRIM_POINTS;
+        break;
+    case GL_LINES:
+        prim = PRIM_LINES;
+        n &= ~1;
+        break;
+    case GL_TRIANGLES:
+        prim = PRIM_TRIANGLES;
+        n -= n % 3;
+        break;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP: {
+        prim = PRIM_LINES;
+        int edges = (mode == GL_LINE_LOOP) ? n : n - 1;
+        if (n < 2 || !(out = arena.allocArray<RenderVertex>(edges * 2))) return;
+        for (int i = 0; i < edges; ++i) {
+            out[outCount++] = in[i];
+            out[outCount++] = in[(i + 1) % n];
+        }
+        break;
+    }
+    case GL_QUADS: {
+        prim = PRIM_TRIANGLES;
+        int quads = n / 4;
+        if (quads == 0 || !(out = arena.allocArray<RenderVertex>(quads * 6))) return;
+        for (int q = 0; q < quads; ++q) {
+            const RenderVertex* v = in + q * 4;
+            out[outCount++] = v[0]; out[outCount++] = v[1]; out[outCount++] = v[2];
+            out[outCount++] = v[0]; out[outCount++] = v[2]; out[outCount++] = v[3];
+        }
+        break;
+    }
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON: {
+        prim = PRIM_TRIANGLES;
+        if (n < 3 || !(out = arena.allocArray<RenderVertex>((n - 2) * 3))) return;
+        for (int i = 1; i + 1 < n; ++i) {
+            out[outCount++] = in[0];
+            out[outCount++] = in[i];
+            out[outCount++] = in[i + 1];
+        }
+        break;
+    }
+    default:
+        return; // unsupported primitive, dropped
+    }
+
+    RenderCommand* cmd = newCommand(prim);
+    if (!cmd) return;
+    cmd->verts = out ? out : in;
+    cmd->count = out ? outCount : n;
+    setBounds(*cmd);
+}
+
+void rcText(GLfloat x, GLfloat y, void* font, const char* text) {
+    size_t len = std::strlen(text);
+    char* copy = arena.allocArray<char>(len + 1);
+    RenderVertex* pos = arena.allocArray<RenderVertex>(1);
+    if (!copy || !pos) return;
+    std::memcpy(copy, text, len + 1);
+
+    const Affine2D& m = matrixStack[matrixTop];
+    pos->x = m.a * x + m.c * y + m.e;
+    pos->y = m.b * x + m.d * y + m.f;
+
+    RenderCommand* cmd = newCommand(PRIM_TEXT);
+    if (!cmd) return;
+    cmd->verts = pos;
+    cmd->count = 1;
+    cmd->font  = font;
+    cmd->text  = copy;
+    cmd->lo    = *pos;
+    cmd->hi    = *pos;
+}
+
+// =====================================================
+// Submission
+// =====================================================
+
+struct SortEntry {
+    const RenderCommand* cmd;
+};
+
+// Layer, then ordering group; inside a group fills go first, then by state,
+// and the record index keeps the sort deterministic.
+static bool drawsBefore(const SortEntry& l, const SortEntry& r) {
+    const RenderCommand& a = *l.cmd;
+    const RenderCommand& b = *r.cmd;
+    if (a.layer != b.layer)       return a.layer < b.layer;
+    if (a.group != b.group)       return a.group < b.group;
+    if (a.prim != b.prim)         return a.prim < b.prim;
+    if (a.blend != b.blend)       return a.blend < b.blend;
+    if (a.colorKey != b.colorKey) return a.colorKey < b.colorKey;
+    if (a.prim == PRIM_LINES && a.lineWidth != b.lineWidth) return a.lineWidth < b.lineWidth;
+    return a.seq < b.seq;
+}
+
+// True if 'b' can be appended to the batch started by 'a'
+static bool sameState(const RenderCommand& a, const RenderCommand& b) {
+    return a.prim != PRIM_TEXT && a.prim == b.prim &&
+           a.layer == b.layer && a.blend == b.blend && a.colorKey == b.colorKey &&
+           (a.prim != PRIM_LINES || a.lineWidth == b.lineWidth);
+}
+
+static const GLenum GL_PRIMS[] = {GL_TRIANGLES, GL_LINES, GL_POINTS};
+
+RenderBatches renderBuild(RenderLayer first, RenderLayer last) {
+    PROFILE_SCOPE("renderBuild");
+
+    int total = 0;
+    for (const RenderCommand* c = firstCmd; c; c = c->next) {
+        if (c->layer >= first && c->layer <= last) ++total;
+    }
+    if (total == 0) return {nullptr, 0};
+
+    // Sort array and batches live in the arena too; released with the frame
+    SortEntry* order = arena.allocArray<SortEntry>(total);
+    const RenderCommand** draws = arena.allocArray<const RenderCommand*>(total);
+    if (!order || !draws) return {nullptr, 0};
+
+    int n = 0;
+    for (const RenderCommand* c = firstCmd; c; c = c->next) {
+        if (c->layer >= first && c->layer <= last) order[n++].cmd = c;
+    }
+    std::sort(order, order + n, drawsBefore);
+
+    int count = 0;
+    for (int i = 0; i < n; ) {
+        const RenderCommand& head = *order[i].cmd;
+
+        // Extent of the run sharing head's state
+        int j = i + 1;
+        int verts = head.count;
+        while (j < n && sameState(head, *order[j].cmd)) {
+            verts += order[j].cmd->count;
+            ++j;
+        }
+
+        // Single command: drawn in place. Run: one command over the
+        // concatenated vertices.
+        draws[count] = &head;
+        if (j - i > 1) {
+            RenderCommand* batch = arena.allocArray<RenderCommand>(1);
+            RenderVertex*  dst   = arena.allocArray<RenderVertex>(verts);
+            if (batch && dst) {
+                *batch = head;
+                batch->verts = dst;
+                batch->count = verts;
+                for (int k = i; k < j; ++k) {
+                    const RenderCommand& c = *order[k].cmd;
+                    std::memcpy(dst, c.verts, sizeof(RenderVertex) * c.count);
+                    dst += c.count;
+                    batch->lo.x = std::min(batch->lo.x, c.lo.x); batch->hi.x = std::max(batch->hi.x, c.hi.x);
+                    batch->lo.y = std::min(batch->lo.y, c.lo.y); batch->hi.y = std::max(batch->hi.y, c.hi.y);
+                }
+                draws[count] = batch;
+            } else {
+                j = i + 1;   // arena full: fall back to one draw per command
+            }
+        }
+        ++count;
+        i = j;
+    }
+
+    stats.batches += count;
+    return {draws, count};
+}
+
+// Issues the batches overlapping 'view' (left, bottom, right, top), or all
+// of them when it is null
+static void replay(const RenderBatches& batches, const GLfloat* view) {
+    if (batches.count == 0) return;
+
+    // State goes through the cache, so what the previous submit (or pass,
+    // or frame) left set is not set again
+    gsMatrixMode(GL_MODELVIEW);
+    gsLoadIdentity();
+    gsEnableVertexArray();
+
+    for (int i = 0; i < batches.count; ++i) {
+        const RenderCommand& draw = *batches.draws[i];
+
+        if (view && (draw.hi.x < view[0] || draw.hi.y < view[1] ||
+                     draw.lo.x > view[2] || draw.lo.y > view[3])) {
+            ++stats.culled;
+            continue;
+        }
+
+        gsColor4fv(draw.color);
+        if (draw.blend) gsEnable(GL_BLEND);
+        else            gsDisable(GL_BLEND);
+
+        if (draw.prim == PRIM_TEXT) {
+            glRasterPos2f(draw.verts[0].x, draw.verts[0].y);
+            for (const char* t = draw.text; *t; ++t) glutBitmapCharacter(draw.font, *t);
+        } else {
+            if (draw.prim == PRIM_LINES) gsLineWidth(draw.lineWidth);
+            glVertexPointer(2, GL_FLOAT, 0, draw.verts);
+            glDrawArrays(GL_PRIMS[draw.prim], 0, draw.count);
+        }
+    }
+    // The vertex array stays enabled: immediate-mode passes ignore it
+}
+
+void renderReplay(const RenderBatches& batches) {
+    PROFILE_SCOPE("renderReplay");
+    replay(batches, nullptr);
+}
+
+void renderReplay(const RenderBatches& batches, GLfloat left, GLfloat bottom, GLfloat width, GLfloat height) {
+    PROFILE_SCOPE("renderReplay");
+    const GLfloat view[4] = {left, bottom, left + width, bottom + height};
+    replay(batches, view);
+}
+
+void renderSubmit(RenderLayer first, RenderLayer last) {
+    PROFILE_SCOPE("renderSubmit");
+
+    // Batches are only needed until the draws were issued
+    size_t mark = arena.top;
+    renderReplay(renderBuild(first, last));
+    arena.top = mark;
+}
+
+// =====================================================
+// Baked layers
+// =====================================================
+
+GLuint renderBake(GLuint list, RenderLayer first, RenderLayer last) {
+    PROFILE_SCOPE("renderBake");
+
+    if (!list) list = glGenLists(1);
+
+    // Nothing is assumed to be set already, so the list is complete on its
+    // own; compiling executes nothing, so nothing is known afterwards either
+    gsInvalidate();
+    glNewList(list, GL_COMPILE);
+    renderSubmit(first, last);
+    glEndList();
+    gsInvalidate();
+    return list;
+}
+
+void renderCallBaked(GLuint list) {
+    glCallList(list);
+    gsInvalidate();
+}
+
+// =====================================================
+// Debug dump
+// =====================================================
+
+void renderDumpFrame(std::FILE* out) {
+    static const char* PRIM_NAMES[] = {"triangles", "lines", "points", "text"};
+    const RenderStats& s = renderStats();
+
+    std::fprintf(out, "# %d commands, arena %zu / %zu bytes\n", s.commands, s.arenaUsed, s.arenaCapacity);
+    std::fprintf(out, "# seq layer group prim count blend lineWidth rgba [text]\n");
+    for (const RenderCommand* c = firstCmd; c; c = c->next) {
+        std::fprintf(out, "%u %d %u %s %d %d %.1f %08x",
+                     c->seq, c->layer, c->group, PRIM_NAMES[c->prim], c->count,
+                     c->blend ? 1 : 0, c->lineWidth, c->colorKey);
+        if (c->prim == PRIM_TEXT) std::fprintf(out, " \"%s\"", c->text);
+        std::fprintf(out, "\n");
+    }
+}
@@ -0,0 +1,173 @@
+// render.h
+#ifndef RENDER_H
+#define RENDER_H
+
+// Recorded render command buffer.
+//
+// The draw code (graphics.cpp, game.cpp) no longer talks to GL directly: it
+// records commands with an immediate-mode shaped API (rcBegin / rcVertex /
+// rcEnd, rcColor, rcPushMatrix ...). Vertices are transformed on the CPU when
+// recorded, and commands + vertex data live in a per-frame bump arena that is
+// reset by renderBeginFrame(), so recording a frame never touches the heap.
+//
+// renderSubmit() sorts the commands and merges runs with identical state into
+// a single glDrawArrays; the state itself is set through the GL state cache
+// (glstate.h), which drops what is already current. Draw order is preserved except inside an
+// rcBeginUnordered() / rcEndUnordered() group, where the caller promises the
+// commands do not overlap, so they may be regrouped by state.
+//
+// The sorted, merged draws can also be kept and issued several times
+// (renderBuild / renderReplay: one split-screen viewport each, only the
+// projection differs, and batches outside the view are skipped), or compiled into a display list that outlives the
+// frame (renderBake: the static scene).
+
+#include <GL/gl.h>
+#include <cstddef>
+#include <cstdio>
+
+// ---- Per-frame bump arena ----
+
+struct FrameArena {
+    unsigned char* base     = nullptr;
+    size_t         capacity = 0;
+    size_t         top      = 0;
+    size_t         overflow = 0;   // bytes requested past capacity this frame
+
+    // Returns nullptr (and records the overflow) when the arena is full
+    void* alloc(size_t bytes, size_t align);
+
+    template <class T>
+    T* allocArray(size_t count) { return static_cast<T*>(alloc(sizeof(T) * count, alignof(T))); }
+
+    // Rewinds to empty. If the last frame overflowed, the arena grows here
+    // (between frames), so steady-state frames do no heap allocation.
+    void reset();
+};
+
+// ---- Command data ----
+
+// Draw order layers, submitted in this order
+enum RenderLayer {
+    LAYER_GROUND = 0,   // background, track (terrain decals go on top, see terrain.h)
+    LAYER_STATIC,       // scenery, obstacles
+    LAYER_WORLD,        // targets, tanks, bullets
+    LAYER_HUD,          // text and overlays in window coordinates
+    LAYER_COUNT
+};
+
+// Primitive the backend submits. Every GL primitive recorded is converted to
+// one of these list types so consecutive commands can be concatenated.
+enum RenderPrim {
+    PRIM_TRIANGLES = 0,
+    PRIM_LINES,
+    PRIM_POINTS,
+    PRIM_TEXT
+};
+
+struct RenderVertex {
+    GLfloat x, y;
+};
+
+struct RenderCommand {
+    RenderCommand* next;       // record order
+    unsigned       seq;        // record index
+    unsigned       group;      // ordering group (shared inside rcBeginUnordered)
+    unsigned char  layer;
+    unsigned char  prim;       // RenderPrim
+    bool           blend;
+    GLfloat        lineWidth;
+    GLfloat        color[4];
+    unsigned       colorKey;   // color packed to RGBA8, used for sorting / merging
+
+    const RenderVertex* verts; // transformed vertices (PRIM_TEXT: raster position)
+    int                 count;
+    RenderVertex        lo, hi;    // bounds of verts, lines and points grown by their width
+
+    void*       font;          // PRIM_TEXT only
+    const char* text;
+};
+
+// Draws of a layer range after sorting and merging: a run of commands with
+// the same state is one command over the concatenated vertices
+struct RenderBatches {
+    const RenderCommand* const* draws;
+    int                         count;
+};
+
+struct RenderStats {
+    int    commands;       // recorded this frame
+    int    batches;        // draws after sorting + merging, over every build of the frame (replays not counted)
+    int    culled;         // batches skipped by view-culled replays
+    size_t arenaUsed;
+    size_t arenaCapacity;
+};
+
+// --- Frame lifecycle (Defined in render.cpp) ---
+
+// Resets the arena and starts recording a new frame
+void renderBeginFrame();
+
+// Sorts, merges and issues every recorded command of layers [first, last].
+// The frame is left intact, so it can be submitted again or dumped.
+void renderSubmit(RenderLayer first = LAYER_GROUND, RenderLayer last = LAYER_HUD);
+
+// Sorts and merges layers [first, last] without issuing them; the batches
+// live in the arena until the next renderBeginFrame()
+RenderBatches renderBuild(RenderLayer first, RenderLayer last);
+
+// Issues built batches (any number of times, e.g. once per viewport)
+void renderReplay(const RenderBatches& batches);
+
+// Same, but skips batches whose bounds miss the world rectangle a split-screen
+// view shows (text is kept only if its raster position is inside, as GL does)
+void renderReplay(const RenderBatches& batches, GLfloat left, GLfloat bottom, GLfloat width, GLfloat height);
+
+// --- Baked layers (display lists, survive renderBeginFrame) ---
+
+// Compiles the batches of layers [first, last] into display list 'list'
+// (0: a new list) and returns it. The list sets every state it relies on.
+GLuint renderBake(GLuint list, RenderLayer first, RenderLayer last);
+
+// Calls a baked list; the state it leaves behind is forgotten by the GL
+// state cache
+void renderCallBaked(GLuint list);
+
+// Writes the recorded commands in record order (debugging aid)
+void renderDumpFrame(std::FILE* out);
+
+const RenderStats& renderStats();
+
+// --- Recording state ---
+
+void rcLayer(RenderLayer layer);
+void rcColor3f(GLfloat r, GLfloat g, GLfloat b);
+void rcColor3fv(const GLfloat color[3]);
+void rcColor4fv(const GLfloat color[4]);
+void rcLineWidth(GLfloat width);
+void rcBlend(bool enabled);   // blend func is always SRC_ALPHA / ONE_MINUS_SRC_ALPHA
+
+// Commands recorded between these may be reordered by state (must not overlap)
+void rcBeginUnordered();
+void rcEndUnordered();
+
+// --- CPU transform stack (same semantics as the GL modelview calls) ---
+
+void rcLoadIdentity();
+void rcPushMatrix();
+void rcPopMatrix();
+void rcTranslatef(GLfloat x, GLfloat y);
+void rcRotatef(GLfloat degrees);
+void rcScalef(GLfloat sx, GLfloat sy);
+void rcMultMatrixf(const GLfloat m[16]);   // column-major 4x4, only the 2D part is used
+
+// --- Geometry ---
+
+// Accepts GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_LINE_LOOP, GL_TRIANGLES,
+// GL_TRIANGLE_FAN, GL_QUADS and GL_POLYGON (convex, like GL requires)
+void rcBegin(GLenum mode);
+void rcVertex2f(GLfloat x, GLfloat y);
+void rcEnd();
+
+void rcText(GLfloat x, GLfloat y, void* font, const char* text);
+
+#endif // RENDER_H
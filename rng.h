@@ -0,0 +1,54 @@
+// rng.h
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+#include "fixed.h"   // Fixed
+
+// Seedable random streams for the simulation (PCG32, XSH-RR variant).
+//
+// Each system owns its own Rng, so how many numbers one draws never shifts
+// what another one sees: the same seed gives the same target layout however
+// many bots are driving around. Streams of one seed are independent
+// sequences (different increments), not offsets into one sequence.
+//
+// Integer only and a few instructions per draw, cheap enough for spawning
+// thousands of entities in one tick.
+
+enum RngStream : uint64_t {
+    RNG_STREAM_SPAWN = 1   // target placement (resetTargets)
+};
+
+struct Rng {
+    uint64_t state;
+    uint64_t inc;   // always odd
+};
+
+constexpr uint32_t rngNext(Rng& rng) {
+    uint64_t old = rng.state;
+    rng.state = old * 6364136223846793005ull + rng.inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot        = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+constexpr Rng rngSeed(uint64_t seed, uint64_t stream) {
+    Rng rng = {0, (stream << 1) | 1};
+    rngNext(rng);
+    rng.state += seed;
+    rngNext(rng);
+    return rng;
+}
+
+// Uniform in [0, n), by multiply-shift (bias below 2^-32 * n)
+constexpr uint32_t rngBelow(Rng& rng, uint32_t n) {
+    return (uint32_t)(((uint64_t)rngNext(rng) * n) >> 32);
+}
+
+// Uniform in [a, b)
+constexpr Fixed rngFixed(Rng& rng, Fixed a, Fixed b) {
+    return Fixed::fromRaw(a.raw + (int32_t)rngBelow(rng, (uint32_t)(b.raw - a.raw)));
+}
+
+#endif // RNG_H
@@ -0,0 +1,115 @@
+// scheduler.cpp
+#include <algorithm>
+
+#include "scheduler.h"
+
+// =====================================================
+// Storage
+// =====================================================
+
+struct Timer {
+    unsigned long long wake;
+    unsigned long long seq;    // insertion order, keeps equal wake ticks FIFO
+    SimTaskHandle      task;
+};
+
+// std::push_heap builds a max-heap; invert the order to get the earliest on top
+static bool laterThan(const Timer& a, const Timer& b) {
+    if (a.wake != b.wake) return a.wake > b.wake;
+    return a.seq > b.seq;
+}
+
+static std::vector<Timer>         timers;
+static std::vector<SimTaskHandle> tasks;     // every live task (for schedReset)
+static unsigned long long         now      = 0;
+static unsigned long long         timerSeq = 0;
+
+static void addTimer(unsigned long long wake, SimTaskHandle task) {
+    timers.push_back({wake, timerSeq++, task});
+    std::push_heap(timers.begin(), timers.end(), laterThan);
+}
+
+// =====================================================
+// Task lifetime
+// =====================================================
+
+SimTask::promise_type::promise_type() {
+    slot = tasks.size();
+    tasks.push_back(SimTaskHandle::from_promise(*this));
+}
+
+// Runs when the task finishes or is destroyed by schedReset()
+SimTask::promise_type::~promise_type() {
+    if (waitingOn) {
+        std::vector<SimTaskHandle>& w = waitingOn->waiters;
+        w.erase(std::find(w.begin(), w.end(), SimTaskHandle::from_promise(*this)));
+    }
+
+    // Swap-remove by index: schedReset() destroys every task, so a search
+    // here would make it quadratic
+    SimTaskHandle last = tasks.back();
+    tasks[slot] = last;
+    last.promise().slot = slot;
+    tasks.pop_back();
+}
+
+// =====================================================
+// Awaitables
+// =====================================================
+
+void SleepTicks::await_suspend(SimTaskHandle task) {
+    addTimer(now + ticks, task);
+}
+
+void SimSignal::Awaiter::await_suspend(SimTaskHandle task) {
+    task.promise().waitingOn = &signal;
+    signal.waiters.push_back(task);
+}
+
+void SimSignal::notify() {
+    for (SimTaskHandle task : waiters) {
+        task.promise().waitingOn = nullptr;
+        addTimer(now, task);
+    }
+    waiters.clear();
+}
+
+// =====================================================
+// Scheduler
+// =====================================================
+
+void schedSpawn(SimTask task) {
+    task.handle.resume();
+}
+
+void schedRun(unsigned long long tick) {
+    while (!timers.empty() && timers.front().wake <= tick) {
+        std::pop_heap(timers.begin(), timers.end(), laterThan);
+        Timer timer = timers.back();
+        timers.pop_back();
+
+        // The task sees the tick it was due at, so its next sleep counts from
+        // there even when 'tick' jumped several ticks ahead (fast-forward)
+        now = timer.wake;
+        timer.task.resume();   // may add timers due by 'tick'; they run in this loop too
+    }
+    now = tick;
+}
+
+void schedReset(unsigned long long tick) {
+    timers.clear();
+    while (!tasks.empty()) tasks.back().destroy();   // the promise removes itself
+    now = tick;
+}
+
+unsigned long long schedNow() {
+    return now;
+}
+
+int schedTaskCount() {
+    return (int)tasks.size();
+}
+
+int schedTimerCount() {
+    return (int)timers.size();
+}
@@ -0,0 +1,99 @@
+// scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+// Coroutine scheduler on simulation ticks (sim thread only).
+//
+// Time-based game logic is written as coroutines that suspend on
+//     co_await sleep_ticks(n);     // resume n ticks from now
+//     co_await signal.wait();      // resume on the next signal.notify()
+// Suspended tasks sit in a binary min-heap ordered by wake tick, so a tick
+// costs O(1) when nothing is due and O(log n) per timer that expires; no
+// per-tick scan over tasks or entities.
+//
+//     static SimTask countdown() {
+//         while (timeLeft > 0) {
+//             co_await sleep_ticks(TICKS_PER_SECOND);
+//             --timeLeft;
+//         }
+//     }
+//     schedSpawn(countdown());
+//
+// Tasks start running inside schedSpawn() up to their first co_await and are
+// destroyed when they finish or by schedReset().
+
+struct SimSignal;
+
+// Fire-and-forget task owned by the scheduler
+struct SimTask {
+    struct promise_type {
+        SimSignal* waitingOn = nullptr;   // signal this task is parked on, if any
+        size_t     slot      = 0;         // index in the scheduler's task list
+
+        promise_type();
+        ~promise_type();
+
+        SimTask get_return_object() { return SimTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }   // schedSpawn starts it
+        std::suspend_never  final_suspend() noexcept { return {}; }     // frame frees itself
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+using SimTaskHandle = std::coroutine_handle<SimTask::promise_type>;
+
+// Awaitable returned by sleep_ticks()
+struct SleepTicks {
+    unsigned long long ticks;
+
+    bool await_ready() const noexcept { return ticks == 0; }
+    void await_suspend(SimTaskHandle task);
+    void await_resume() const noexcept {}
+};
+
+// Suspends the calling task for 'ticks' simulation ticks (0 = no suspension)
+inline SleepTicks sleep_ticks(unsigned long long ticks) { return SleepTicks{ticks}; }
+
+// Event tasks can wait for. notify() does not resume anyone on the spot: the
+// waiters are queued to run at the current tick's schedRun(), so a signal can
+// be raised from the middle of an entity loop.
+struct SimSignal {
+    std::vector<SimTaskHandle> waiters;
+
+    struct Awaiter {
+        SimSignal& signal;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(SimTaskHandle task);
+        void await_resume() const noexcept {}
+    };
+
+    Awaiter wait() { return Awaiter{*this}; }
+    void notify();
+};
+
+// --- Scheduler (Defined in scheduler.cpp) ---
+
+// Runs the task until its first suspension
+void schedSpawn(SimTask task);
+
+// Sets the current tick and resumes every task due at or before it, in wake
+// order (ties: first scheduled first). While a task runs, schedNow() is the
+// tick it was due at, so skipping ticks does not stretch its sleeps.
+void schedRun(unsigned long long tick);
+
+// Destroys every suspended task, clears the timer heap and sets the current
+// tick (new round). Not to be called from inside a task.
+void schedReset(unsigned long long tick);
+
+unsigned long long schedNow();
+int schedTaskCount();    // live tasks
+int schedTimerCount();   // tasks waiting in the heap
+
+#endif // SCHEDULER_H
@@ -0,0 +1,90 @@
+// simthread.cpp
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "game.h"      // updateGame, publishSnapshot, recordTelemetry, TICKS_PER_SECOND
+#include "simthread.h"
+#include "profiler.h"
+
+// =====================================================
+// Input queue
+// =====================================================
+
+struct InputEvent {
+    int  key;
+    bool special;   // GLUT special key (arrows) rather than an ASCII key
+};
+
+constexpr unsigned INPUT_QUEUE_SIZE = 64;   // power of two
+
+static InputEvent            inputQueue[INPUT_QUEUE_SIZE];
+static std::atomic<unsigned> inputHead{0};   // next slot to read  (sim thread)
+static std::atomic<unsigned> inputTail{0};   // next slot to write (GLUT thread)
+
+static bool pushInput(int key, bool special) {
+    unsigned tail = inputTail.load(std::memory_order_relaxed);
+    if (tail - inputHead.load(std::memory_order_acquire) == INPUT_QUEUE_SIZE) return false;
+
+    inputQueue[tail % INPUT_QUEUE_SIZE] = {key, special};
+    inputTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool queueKeyboard(unsigned char key) { return pushInput(key, false); }
+bool queueSpecial(int key)            { return pushInput(key, true); }
+
+void drainInputQueue() {
+    unsigned head = inputHead.load(std::memory_order_relaxed);
+    unsigned tail = inputTail.load(std::memory_order_acquire);
+
+    for (; head != tail; ++head) {
+        const InputEvent& e = inputQueue[head % INPUT_QUEUE_SIZE];
+        if (e.special) applySpecial(e.key);
+        else           applyKeyboard((unsigned char)e.key);
+    }
+    inputHead.store(head, std::memory_order_release);
+}
+
+// =====================================================
+// Thread
+// =====================================================
+
+static std::thread       simThread;
+static std::atomic<bool> simRunning{false};
+
+static void simLoop() {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds(1000000000LL / TICKS_PER_SECOND);
+    auto next = Clock::now();
+
+    profilerRegisterThread("sim");
+
+    while (simRunning.load(std::memory_order_acquire)) {
+        profilerBeginFrame();
+
+        auto tickStart = Clock::now();
+        drainInputQueue();
+        updateGame();
+        publishSnapshot();
+        auto tickMicros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tickStart);
+        recordTelemetry((unsigned)tickMicros.count());
+
+        // Fixed tick rate. After a long stall (debugger, suspend) resync
+        // instead of running a burst of catch-up ticks.
+        next += period;
+        auto now = Clock::now();
+        if (now - next > period * 5) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void startSimThread() {
+    if (simRunning.exchange(true)) return;
+    simThread = std::thread(simLoop);
+}
+
+void stopSimThread() {
+    if (!simRunning.exchange(false)) return;
+    if (simThread.joinable()) simThread.join();
+}
@@ -0,0 +1,29 @@
+// simthread.h
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+// Simulation thread.
+//
+// updateGame() runs on its own thread at TICKS_PER_SECOND, independent of the
+// GLUT thread's vsync / driver stalls. After each tick it publishes a
+// WorldSnapshot (see game.h) that the GLUT thread renders.
+//
+// Gameplay input reaches the sim through a single-producer / single-consumer
+// lock-free queue: the GLUT callbacks push, the sim thread drains before
+// each tick.
+
+// --- Thread control (Defined in simthread.cpp) ---
+
+void startSimThread();
+void stopSimThread();    // joins; safe to call when not running
+
+// --- Input queue (GLUT thread -> sim thread) ---
+
+// Returns false if the queue is full (the key press is dropped)
+bool queueKeyboard(unsigned char key);
+bool queueSpecial(int key);
+
+// Applies every queued key press; called by the sim thread before a tick
+void drainInputQueue();
+
+#endif // SIMTHREAD_H
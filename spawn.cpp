@@ -0,0 +1,261 @@
+// spawn.cpp
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include "spawn.h"
+
+constexpr int SPAWN_FILL_PERCENT = 60;   // count * d^2 = 60% of the area: the filled area holds ~1.25 x count spots
+constexpr int SEED_TRIES         = 32;   // random spots tried when every placed one is retired
+constexpr int OBSTACLE_REROLLS   = 16;   // leftovers: tries to land clear of obstacles
+constexpr int RING_STEPS         = 64;   // candidate directions around a spot
+constexpr int GRID_PAD           = 2;    // empty cells around the grid: neighbour rings need no clamping
+constexpr int SHADOW_STEPS       = 9;    // ring steps either side of a neighbour's direction that land within d of it
+constexpr int NO_PARENT          = -1;
+
+static_assert(RING_STEPS % SPAWN_CANDIDATES == 0, "candidates are spread evenly over the ring");
+
+// Two spots 'reach' from the same one, up to 9 steps of 5.625 degrees
+// apart, are at most 2 * sin(25.3 deg) * reach = 0.91 d from each other
+static_assert(SHADOW_STEPS * 360 / RING_STEPS <= 51, "shadowed candidates must fall within d of the neighbour");
+static_assert(RING_STEPS / SPAWN_CANDIDATES <= SHADOW_STEPS, "the candidate after an added one is shadowed");
+static_assert(RING_STEPS == 64, "shadowed ring steps are one bit each of a uint64_t");
+
+// Ring steps within SHADOW_STEPS of 'dir'
+static uint64_t shadowOf(int dir) {
+    constexpr uint64_t SHADOW = ((uint64_t)1 << (2 * SHADOW_STEPS + 1)) - 1;   // centred on bit SHADOW_STEPS
+    return std::rotl(SHADOW, dir - SHADOW_STEPS);
+}
+
+// A grid cell holds the spot in it (raw Fixed) or EMPTY_CELL, far enough
+// away from everything to never be within d
+struct GridCell {
+    int32_t x, y;
+};
+constexpr int32_t EMPTY_CELL = -(1 << 29);
+
+// What the obstacles leave of a cell, for circles centred in it: all of it
+// clear, none of it, or only part (the candidate itself is tested)
+enum CellCover : uint8_t {
+    COVER_CLEAR,
+    COVER_BLOCKED,
+    COVER_EDGE,
+};
+
+// A spot that may still get neighbours, and the ring step pointing back to
+// the spot it grew from (NO_PARENT for seeds)
+struct ActiveSpot {
+    int32_t spot;
+    int32_t back;
+};
+
+// Reused between waves: only grow, so a steady wave size allocates nothing
+static std::vector<GridCell>   grid;
+static std::vector<uint8_t>    cover;      // CellCover, parallel to 'grid'
+static std::vector<SpawnPoint> spots;      // every spot of the filled area
+static std::vector<ActiveSpot> active;     // spots that may still get neighbours
+static std::vector<AABB>       blockers;   // obstacles reaching into the area
+
+// Placement of the current call
+static AABB       area;
+static Fixed      cell;
+static int64_t    cellInv;      // 2^32 / cell.raw: column / row by multiply instead of divide
+static int        cols, rows;   // without the padding
+static int64_t    minDistSq;    // Q32.32
+static Fixed      clearance;    // circle radius, for the obstacle test
+static SpawnPoint ring[RING_STEPS];
+static int        innerDelta[8];    // INNER_RING / OUTER_RING as padded grid index offsets
+static int        outerDelta[16];
+
+// Padded grid index of the cell holding (x, y), which must be inside the area
+static int cellOf(Fixed x, Fixed y) {
+    int col = std::min((int)(((x - area.minX).raw * cellInv) >> 32), cols - 1);
+    int row = std::min((int)(((y - area.minY).raw * cellInv) >> 32), rows - 1);
+    return (row + GRID_PAD) * (cols + 2 * GRID_PAD) + col + GRID_PAD;
+}
+
+// Neighbour cells that can hold a spot within d (cells are just under
+// d / sqrt(2) wide, so two cells away still counts, corners included): the
+// ring around the candidate's cell, then the ring around that. {col, row}.
+static const int INNER_RING[8][2]  = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+static const int OUTER_RING[16][2] = {{-2, -2}, {-1, -2}, {0, -2}, {1, -2}, {2, -2},
+                                      {-2,  2}, {-1,  2}, {0,  2}, {1,  2}, {2,  2},
+                                      {-2, -1}, {-2,  0}, {-2, 1}, {2, -1}, {2,  0}, {2, 1}};
+
+// Inside the area, at least d from every spot placed and clear of obstacles.
+// Cheapest rejections first: a taken cell, then the inner ring, which is
+// where nearly every remaining candidate fails. Each ring is tested without
+// branches.
+static bool fits(Fixed x, Fixed y) {
+    if (x < area.minX || x >= area.maxX || y < area.minY || y >= area.maxY) return false;
+
+    int index = cellOf(x, y);
+    if (grid[index].x != EMPTY_CELL || cover[index] == COVER_BLOCKED) return false;
+
+    auto tooClose = [&](int delta) {
+        const GridCell& spot = grid[index + delta];
+        int64_t dx = (int64_t)spot.x - x.raw;
+        int64_t dy = (int64_t)spot.y - y.raw;
+        return dx * dx + dy * dy < minDistSq;
+    };
+
+    bool near = false;
+    for (int delta : innerDelta) near |= tooClose(delta);
+    if (near) return false;
+    for (int delta : outerDelta) near |= tooClose(delta);
+    if (near) return false;
+
+    if (cover[index] == COVER_CLEAR) return true;
+    AABB box = {x - clearance, y - clearance, x + clearance, y + clearance};
+    return !overlapsObstacle(box);
+}
+
+// Marks the cells obstacles reach, once per call, so most candidates need
+// no BVH query. A circle centred at (x, y) overlaps an obstacle iff (x, y)
+// is strictly inside the obstacle grown by the radius. Cell edges are
+// widened by 'slack', the most cellOf's rounded reciprocal can misplace a
+// point by, so a cell is only clear or blocked if every point it may be
+// given is.
+static void markCover() {
+    const int stride = cols + 2 * GRID_PAD;
+    cover.assign(grid.size(), COVER_CLEAR);
+
+    int32_t span  = std::max((area.maxX - area.minX).raw, (area.maxY - area.minY).raw);
+    int32_t slack = (int32_t)(((int64_t)span * cell.raw) >> 32) + 2;
+
+    AABB reach = {area.minX - clearance, area.minY - clearance, area.maxX + clearance, area.maxY + clearance};
+    blockers.clear();
+    queryObstacles(reach, blockers);
+
+    for (const AABB& o : blockers) {
+        AABB g = {o.minX - clearance, o.minY - clearance, o.maxX + clearance, o.maxY + clearance};
+
+        auto cellRange = [&](Fixed lo, Fixed hi, Fixed origin, int count, int& first, int& last) {
+            first = std::clamp((int)((int64_t)(lo - origin).raw - slack) / cell.raw, 0, count - 1);
+            last  = std::clamp((int)((int64_t)(hi - origin).raw + slack) / cell.raw, 0, count - 1);
+        };
+        int col0, col1, row0, row1;
+        cellRange(g.minX, g.maxX, area.minX, cols, col0, col1);
+        cellRange(g.minY, g.maxY, area.minY, rows, row0, row1);
+
+        for (int row = row0; row <= row1; ++row) {
+            int32_t y0 = area.minY.raw + row * cell.raw - slack;
+            int32_t y1 = area.minY.raw + (row + 1) * cell.raw + slack;
+            bool insideY = y0 > g.minY.raw && y1 < g.maxY.raw;
+            for (int col = col0; col <= col1; ++col) {
+                int32_t x0 = area.minX.raw + col * cell.raw - slack;
+                int32_t x1 = area.minX.raw + (col + 1) * cell.raw + slack;
+                bool inside = insideY && x0 > g.minX.raw && x1 < g.maxX.raw;
+
+                uint8_t& c = cover[(row + GRID_PAD) * stride + col + GRID_PAD];
+                if (inside)                   c = COVER_BLOCKED;
+                else if (c != COVER_BLOCKED)  c = COVER_EDGE;
+            }
+        }
+    }
+}
+
+int spawnScatter(Rng& rng, const AABB& bounds, Fixed radius, int count, std::vector<SpawnPoint>& out) {
+    out.resize(count);
+    if (count <= 0) return 0;
+
+    // Spacing: as wide as 'count' spots allow
+    Fixed   width  = bounds.maxX - bounds.minX;
+    Fixed   height = bounds.maxY - bounds.minY;
+    int64_t fitSq  = (int64_t)width.raw * height.raw / 100 * SPAWN_FILL_PERCENT / count;
+    Fixed   d      = Fixed::fromRaw(std::max<int32_t>((int32_t)isqrt64((uint64_t)fitSq), Fixed::ONE));
+
+    area      = bounds;
+    clearance = radius;
+    minDistSq = fxLengthSq(d, Fixed::fromInt(0));
+    cell      = Fixed::fromRaw(std::max<int32_t>(d.raw * 46000LL >> Fixed::FRAC_BITS, 1));   // a bit under d / sqrt(2): one spot per cell
+    cellInv   = ((int64_t)1 << 32) / cell.raw;
+    cols      = width.raw / cell.raw + 1;
+    rows      = height.raw / cell.raw + 1;
+    grid.assign((size_t)(cols + 2 * GRID_PAD) * (rows + 2 * GRID_PAD), GridCell{EMPTY_CELL, EMPTY_CELL});
+    for (int i = 0; i < 8; ++i)  innerDelta[i] = INNER_RING[i][1] * (cols + 2 * GRID_PAD) + INNER_RING[i][0];
+    for (int i = 0; i < 16; ++i) outerDelta[i] = OUTER_RING[i][1] * (cols + 2 * GRID_PAD) + OUTER_RING[i][0];
+    active.clear();
+    spots.clear();
+    markCover();
+
+    // Candidates sit just outside d (rounding must not bring them inside),
+    // in evenly spread directions: denser packing than random ring samples,
+    // with far fewer tries (Roberts' variant of Bridson)
+    Fixed reach = d + Fixed::fromRaw(d.raw / 16 + 1);
+    for (int i = 0; i < RING_STEPS; ++i) {
+        BAngle a = (BAngle)(i * (BANGLE_TURN / RING_STEPS));
+        ring[i]  = {fxCos(a) * reach, fxSin(a) * reach};
+    }
+
+    auto add = [&](Fixed x, Fixed y, int back) {
+        grid[cellOf(x, y)] = {x.raw, y.raw};
+        active.push_back({(int32_t)spots.size(), back});
+        spots.push_back({x, y});
+    };
+
+    // Fill the whole area, so the wave below covers all of it
+    for (;;) {
+        // Nothing left to grow from: first spot, or a region cut off by obstacles
+        if (active.empty()) {
+            int tries = 0;
+            for (; tries < SEED_TRIES; ++tries) {
+                Fixed x = rngFixed(rng, area.minX, area.maxX);
+                Fixed y = rngFixed(rng, area.minY, area.maxY);
+                if (fits(x, y)) {
+                    add(x, y, NO_PARENT);
+                    break;
+                }
+            }
+            if (tries == SEED_TRIES) break;   // full
+            continue;
+        }
+
+        // Take a random active spot, add every ring candidate that fits, retire it.
+        // Candidates close in direction to its parent or to a spot added
+        // this round are within d of it: skipped untested, as fits() would
+        // reject them anyway.
+        int slot = (int)rngBelow(rng, (uint32_t)active.size());
+        ActiveSpot grow = active[slot];
+        SpawnPoint from = spots[grow.spot];
+        active[slot] = active.back();
+        active.pop_back();
+
+        uint64_t shadowed = grow.back != NO_PARENT ? shadowOf(grow.back) : 0;
+
+        int first = (int)rngBelow(rng, RING_STEPS);
+        for (int k = 0; k < SPAWN_CANDIDATES; ++k) {
+            int step = (first + k * RING_STEPS / SPAWN_CANDIDATES) % RING_STEPS;
+            if ((shadowed >> step) & 1) continue;
+
+            Fixed x = from.x + ring[step].x;
+            Fixed y = from.y + ring[step].y;
+            if (fits(x, y)) {
+                add(x, y, (step + RING_STEPS / 2) % RING_STEPS);
+                shadowed |= shadowOf(step);
+            }
+        }
+    }
+
+    // 'count' of them at random (partial Fisher-Yates)
+    int spaced = std::min(count, (int)spots.size());
+    for (int i = 0; i < spaced; ++i) {
+        int j = i + (int)rngBelow(rng, (uint32_t)(spots.size() - i));
+        std::swap(spots[i], spots[j]);
+        out[i] = spots[i];
+    }
+
+    // Leftovers (area cut up by obstacles): anywhere, re-rolled a few times
+    // if inside an obstacle
+    for (int i = spaced; i < count; ++i) {
+        Fixed x, y;
+        for (int tries = 0; tries < OBSTACLE_REROLLS; ++tries) {
+            x = rngFixed(rng, area.minX, area.maxX);
+            y = rngFixed(rng, area.minY, area.maxY);
+            AABB box = {x - radius, y - radius, x + radius, y + radius};
+            if (!overlapsObstacle(box)) break;
+        }
+        out[i] = {x, y};
+    }
+    return spaced;
+}
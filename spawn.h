@@ -0,0 +1,43 @@
+// spawn.h
+#ifndef SPAWN_H
+#define SPAWN_H
+
+#include <vector>
+
+#include "fixed.h"       // Fixed
+#include "obstacles.h"   // AABB
+#include "rng.h"         // Rng
+
+// Spawn placement: scatters circles evenly over an area (targets of a wave).
+//
+// Poisson-disk sampling: the area is filled with spots at least d apart, then
+// 'count' of them are picked at random, so a wave has no clumps or holes and
+// covers the whole area. The fill is Bridson's algorithm with Roberts'
+// candidates: each spot tries SPAWN_CANDIDATES evenly spread directions just
+// outside d. A background grid of cells under d / sqrt(2) holds at most one
+// spot per cell, so a candidate is checked against the 5 x 5 cells around it
+// instead of every spot placed. Obstacles are marked on the same grid once
+// per call, so only candidates in cells an obstacle edge crosses need a BVH
+// query, and candidates pointing back at a spot's neighbours are skipped.
+//
+// d is as wide as 'count' allows (count * d^2 is about 60% of the area), so
+// the circles are only non-overlapping while d >= 2 * radius: up to about
+// 70 targets in the game's wave area (440 x 240 px, radius 15). Bigger waves
+// (stress runs) keep centres d apart, but neighbouring circles overlap.
+// Spots whose circle overlaps an obstacle are rejected. Integer math and a
+// caller-owned Rng, so a seed gives the same layout everywhere.
+
+constexpr int SPAWN_CANDIDATES = 8;   // directions tried around each spot (divides 64)
+
+struct SpawnPoint {
+    Fixed x, y;
+};
+
+// --- Placement (Defined in spawn.cpp, sim thread) ---
+
+// Fills 'out' with 'count' centres of circles of 'radius' inside 'area'.
+// Returns how many of them keep the spacing; the rest (area cut up by
+// obstacles) are uniformly random, still clear of obstacles when possible.
+int spawnScatter(Rng& rng, const AABB& area, Fixed radius, int count, std::vector<SpawnPoint>& out);
+
+#endif // SPAWN_H
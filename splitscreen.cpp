@@ -0,0 +1,71 @@
+// splitscreen.cpp
+#include <GL/glut.h>
+#include <algorithm>
+
+#include "splitscreen.h"
+#include "dynres.h"     // dynresSubViewport (viewports inside the scaled scene)
+#include "glstate.h"
+#include "profiler.h"   // must stay last: hooks GL calls when profiling
+
+// =====================================================
+// Layout
+// =====================================================
+
+// Camera of a cols x rows grid cell: the single-player zoom, centred on the
+// tank but never past the world's edge
+static void follow(SplitView& view, float x, float y, int cols, int rows) {
+    view.width  = (float)WIDTH / cols;
+    view.height = (float)HEIGHT / rows;
+    view.left   = std::clamp(x - view.width / 2.0f, 0.0f, WIDTH - view.width);
+    view.bottom = std::clamp(y - view.height / 2.0f, 0.0f, HEIGHT - view.height);
+}
+
+int splitLayout(int players, const float focus[][2], SplitView views[MAX_SPLIT_VIEWS]) {
+    players = std::clamp(players, 1, MAX_PLAYERS);
+
+    // 1: whole window, 2: side by side, 3-4: quarters, player 1 top left
+    int cols  = players == 1 ? 1 : 2;
+    int rows  = players <= 2 ? 1 : 2;
+    int count = cols * rows;
+
+    for (int i = 0; i < count; ++i) {
+        SplitView& view = views[i];
+        int col = i % cols, row = i / cols;
+        view.x = (float)col / cols;
+        view.y = 1.0f - (float)(row + 1) / rows;
+        view.w = 1.0f / cols;
+        view.h = 1.0f / rows;
+
+        if (i < players) {
+            view.player = i;
+            follow(view, focus[i][0], focus[i][1], cols, rows);
+        } else {
+            view.player = -1;   // spare quarter: the whole battlefield
+            view.left   = 0.0f;
+            view.bottom = 0.0f;
+            view.width  = (float)WIDTH;
+            view.height = (float)HEIGHT;
+        }
+    }
+    return count;
+}
+
+// =====================================================
+// Drawing
+// =====================================================
+
+static void setProjection(float left, float bottom, float width, float height) {
+    gsMatrixMode(GL_PROJECTION);
+    gsLoadIdentity();
+    gluOrtho2D(left, left + width, bottom, bottom + height);
+    gsMatrixChanged();
+}
+
+void splitBeginView(const SplitView& view) {
+    dynresSubViewport(view.x, view.y, view.w, view.h);
+    setProjection(view.left, view.bottom, view.width, view.height);
+}
+
+void splitEndViews() {
+    setProjection(0.0f, 0.0f, (float)WIDTH, (float)HEIGHT);   // as initGraphics left it
+}
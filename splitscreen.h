@@ -0,0 +1,42 @@
+// splitscreen.h
+#ifndef SPLITSCREEN_H
+#define SPLITSCREEN_H
+
+#include "game.h"   // MAX_PLAYERS, WIDTH, HEIGHT
+
+// Split-screen local multiplayer: viewport layout and cameras (GLUT thread).
+//
+// One viewport per local player: the whole window for one, side by side for
+// two, quarters for three or four (with three, the spare quarter shows the
+// whole battlefield). A player's camera keeps the single-player zoom and
+// follows their tank, clamped so it never looks past the edge of the world.
+//
+// Nothing is drawn per viewport except GL calls: drawScene() records the
+// world once, the static scene is a baked display list, and each viewport
+// only sets its projection and replays them (renderReplay / renderCallBaked),
+// skipping world batches that lie outside the rectangle it shows.
+
+constexpr int MAX_SPLIT_VIEWS = 4;
+
+struct SplitView {
+    float x, y, w, h;                   // viewport, fractions of the window from its lower left
+    float left, bottom, width, height;  // world rectangle it shows
+    int   player;                       // whose camera, -1 = battlefield overview
+};
+
+// --- Layout (Defined in splitscreen.cpp) ---
+
+// Views of 'players' local players whose tanks are at focus[i] (world
+// coordinates as drawn, i.e. after reflect / shear); returns how many
+int splitLayout(int players, const float focus[][2], SplitView views[MAX_SPLIT_VIEWS]);
+
+// --- Drawing (between dynresBeginScene and dynresEndScene) ---
+
+// Viewport and projection of one view
+void splitBeginView(const SplitView& view);
+
+// Back to the default projection for the upscale and the HUD
+// (dynresEndScene restores the whole-window viewport)
+void splitEndViews();
+
+#endif // SPLITSCREEN_H
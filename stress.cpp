@@ -0,0 +1,309 @@
+// stress.cpp
+#include <GL/glut.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define PSAPI_VERSION 2   // GetProcessMemoryInfo from kernel32, no psapi.lib
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "game.h"
+#include "scheduler.h"
+#include "stress.h"
+
+// =====================================================
+// Firing patterns (scheduler tasks, one per tank)
+// =====================================================
+
+constexpr int         SPRAY_FIRE_TICKS = 6;
+constexpr BAngle      SPRAY_TURN       = bangleFromDegrees(15.0f);
+constexpr PackedSpeed SPRAY_SPEED      = PackedSpeed::fromFixed(Fixed::fromInt(2));
+constexpr int         VOLLEY_TICKS     = 30;
+constexpr int         IDLE_TURN_TICKS  = 10;
+constexpr BAngle      IDLE_TURN        = bangleFromDegrees(10.0f);
+constexpr PackedSpeed IDLE_SPEED       = PackedSpeed::fromFixed(Fixed::fromFloat(1.5f));
+constexpr BAngle      START_SPREAD     = bangleFromDegrees(37.0f);   // start heading of tank i: i * 37 degrees
+
+// Tank 0 is the player, tank i > 0 is bots[i - 1]
+static Car& stressTank(int tank) {
+    return tank == 0 ? player : bots[tank - 1];
+}
+
+static SimTask sprayScript(int tank) {
+    stressTank(tank).speed = SPRAY_SPEED;
+    stressTank(tank).angle = (BAngle)(tank * START_SPREAD);
+    co_await sleep_ticks(1 + tank % SPRAY_FIRE_TICKS);   // stagger the shots
+
+    for (;;) {
+        Car& c = stressTank(tank);
+        c.angle += SPRAY_TURN;
+        spawnBulletFrom(tank);
+        co_await sleep_ticks(SPRAY_FIRE_TICKS);
+    }
+}
+
+// Every tank turns to a target (spread over the targets) and all fire at once
+static SimTask volleyScript(int tank) {
+    stressTank(tank).speed = PackedSpeed{0};
+
+    for (;;) {
+        co_await sleep_ticks(VOLLEY_TICKS);
+
+        Car& c = stressTank(tank);
+        if (!targets.empty()) {
+            const Target& t = targets[tank % targets.size()];
+            // Forward is (sin(angle), -cos(angle))
+            c.angle = fxAtan2(t.x.toFixed() - c.x.toFixed(), c.y.toFixed() - t.y.toFixed());
+        }
+        spawnBulletFrom(tank);
+    }
+}
+
+static SimTask idleScript(int tank) {
+    stressTank(tank).speed = IDLE_SPEED;
+    stressTank(tank).angle = (BAngle)(tank * START_SPREAD);
+
+    for (;;) {
+        co_await sleep_ticks(IDLE_TURN_TICKS);
+        stressTank(tank).angle += IDLE_TURN;
+    }
+}
+
+static const char* const PATTERN_NAMES[] = {"spray", "volley", "idle"};
+
+static SimTask patternScript(StressPattern pattern, int tank) {
+    switch (pattern) {
+    case STRESS_VOLLEY: return volleyScript(tank);
+    case STRESS_IDLE:   return idleScript(tank);
+    default:            return sprayScript(tank);
+    }
+}
+
+// =====================================================
+// Measurement
+// =====================================================
+
+using StressClock = std::chrono::steady_clock;
+
+static StressConfig            config;
+static std::FILE*              report       = nullptr;
+static int                     step         = 0;
+static int                     stepTick     = 0;
+static int                     stepTanks    = 0;
+static int                     stepBullets  = 0;
+static int                     stepTargets  = 0;
+static StressClock::time_point stepStart;
+static std::vector<float>      frameMs;                      // one entry per frame (K ticks at --step K)
+static double                  phaseNs[SIM_PHASE_COUNT];     // filled by updateGame()
+static double                  snapshotNs   = 0.0;
+static double                  renderNs     = 0.0;
+static bool                    rendering    = false;
+
+static double elapsedNs(StressClock::time_point from, StressClock::time_point to) {
+    return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+// Peak resident set size of the process so far, in KB
+static long long peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return (long long)(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss / 1024;   // bytes on macOS
+#else
+    return (long long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Nearest-rank percentile of sorted samples
+static float percentile(const std::vector<float>& sorted, double p) {
+    if (sorted.empty()) return 0.0f;
+    size_t rank = (size_t)std::ceil(p * sorted.size());
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Fresh world at this step's scale, with one pattern task per tank
+static void startStep() {
+    int scale = 1;
+    for (int i = 0; i < step; ++i) scale *= STRESS_SWEEP_FACTOR;
+
+    stepTanks   = config.tanks * scale;
+    stepBullets = (config.bullets ? config.bullets : MAX_BULLETS) * scale;
+    stepTargets = (config.targets ? config.targets : NUM_TARGETS) * scale;
+
+    setEntityCounts(stepBullets, stepTargets);
+    setBotCount(stepTanks - 1);
+    setRoundSeconds(config.ticks / TICKS_PER_SECOND + 2);   // the round never ends mid-step
+
+    setSimStepTicks(config.simStep);
+    initGame();                 // also cancels the previous step's scripts
+    seedSpawns(STRESS_SEED);    // same target layout every run
+    resetTargets();
+    for (int t = 0; t < stepTanks; ++t) schedSpawn(patternScript(config.pattern, t));
+    publishSnapshot();
+
+    std::fill(phaseNs, phaseNs + SIM_PHASE_COUNT, 0.0);
+    snapshotNs = renderNs = 0.0;
+    frameMs.clear();
+    frameMs.reserve(config.ticks / config.simStep + 1);
+    stepTick  = 0;
+    stepStart = StressClock::now();
+}
+
+static void writeStep() {
+    double wallNs = elapsedNs(stepStart, StressClock::now());
+    std::vector<float> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    int active = bulletActive.count();
+
+    double perTickUs = 1e-3 / std::max(1, stepTick);   // per simulated tick, not per frame
+    std::fprintf(report,
+                 "%s    {\"tanks\": %d, \"bullets\": %d, \"targets\": %d, \"ticks\": %d, "
+                 "\"wall_s\": %.3f, \"ticks_per_sec\": %.1f,\n"
+                 "     \"frame_ms\": {\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n"
+                 "     \"peak_rss_kb\": %lld, \"bullets_in_flight\": %d, \"score\": %d,\n"
+                 "     \"phase_us_per_tick\": {\"tasks\": %.3f, \"tanks\": %.3f, \"fog\": %.3f, "
+                 "\"bullets\": %.3f, \"collision\": %.3f, \"snapshot\": %.3f, \"render\": %.3f}}",
+                 step ? ",\n" : "", stepTanks, stepBullets, stepTargets, stepTick,
+                 wallNs * 1e-9, stepTick / (wallNs * 1e-9),
+                 percentile(sorted, 0.50), percentile(sorted, 0.90), percentile(sorted, 0.99),
+                 sorted.empty() ? 0.0f : sorted.back(),
+                 peakRssKb(), active, acquireSnapshot().score,
+                 phaseNs[SIM_PHASE_TASKS] * perTickUs, phaseNs[SIM_PHASE_TANKS] * perTickUs,
+                 phaseNs[SIM_PHASE_FOG] * perTickUs, phaseNs[SIM_PHASE_BULLETS] * perTickUs,
+                 phaseNs[SIM_PHASE_COLLISION] * perTickUs, snapshotNs * perTickUs, renderNs * perTickUs);
+    std::fflush(report);   // a sweep killed at a huge step keeps the earlier ones
+}
+
+static void finishReport() {
+    std::fprintf(report, "\n  ]\n}\n");
+    if (report != stdout) std::fclose(report);
+    report = nullptr;
+    setSimPhaseTimes(nullptr);
+}
+
+// One frame: tick + snapshot (+ draw). Returns false after the last step.
+static bool stressFrame(bool render) {
+    auto t0 = StressClock::now();
+    updateGame();
+    auto t1 = StressClock::now();
+    publishSnapshot();
+    auto t2 = StressClock::now();
+    if (render) drawScene();
+    auto t3 = StressClock::now();
+
+    snapshotNs += elapsedNs(t1, t2);
+    renderNs   += elapsedNs(t2, t3);
+    frameMs.push_back((float)(elapsedNs(t0, t3) * 1e-6));
+
+    stepTick += config.simStep;
+    if (stepTick < config.ticks) return true;
+
+    writeStep();
+    if (++step == config.steps) return false;
+    startStep();
+    return true;
+}
+
+// =====================================================
+// Public interface
+// =====================================================
+
+static void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s --stress [--tanks N] [--bullets N] [--targets N] [--ticks N]\n"
+                 "       [--pattern spray|volley|idle] [--sweep STEPS] [--step K] [--headless]\n"
+                 "       [--out report.json]\n",
+                 program);
+}
+
+bool stressParseArgs(int argc, char** argv, StressConfig& out) {
+    bool ok = true;
+    for (int i = 1; i < argc && ok; ++i) {
+        const char* arg   = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        int*        count = nullptr;
+
+        if      (!std::strcmp(arg, "--stress"))   out.enabled  = true;
+        else if (!std::strcmp(arg, "--headless")) out.headless = true;
+        else if (!std::strcmp(arg, "--tanks"))    count = &out.tanks;
+        else if (!std::strcmp(arg, "--bullets"))  count = &out.bullets;
+        else if (!std::strcmp(arg, "--targets"))  count = &out.targets;
+        else if (!std::strcmp(arg, "--ticks"))    count = &out.ticks;
+        else if (!std::strcmp(arg, "--sweep"))    count = &out.steps;
+        else if (!std::strcmp(arg, "--step"))     count = &out.simStep;
+        else if (!std::strcmp(arg, "--out")) {
+            ok = value != nullptr;
+            if (ok) out.outPath = argv[++i];
+        } else if (!std::strcmp(arg, "--pattern")) {
+            int p = 0;
+            while (value && p < 3 && std::strcmp(value, PATTERN_NAMES[p])) ++p;
+            ok = value && p < 3;
+            if (ok) out.pattern = (StressPattern)p;
+            ++i;
+        }
+        // Anything else is left to GLUT / the host program
+
+        if (count) {
+            ok = value && std::atoi(value) > 0;
+            if (ok) *count = std::atoi(argv[++i]);
+        }
+    }
+
+    if (!ok) printUsage(argv[0]);
+    return ok;
+}
+
+static void beginRun(const StressConfig& cfg, bool render) {
+    config    = cfg;
+    rendering = render;
+    report    = config.outPath ? std::fopen(config.outPath, "w") : stdout;
+    if (!report) {
+        std::fprintf(stderr, "stress: cannot write %s, using stdout\n", config.outPath);
+        report = stdout;
+    }
+    std::fprintf(report,
+                 "{\n  \"config\": {\"pattern\": \"%s\", \"ticks\": %d, \"step\": %d, \"sweep_factor\": %d, \"render\": %s},\n"
+                 "  \"steps\": [\n",
+                 PATTERN_NAMES[config.pattern], config.ticks, config.simStep, STRESS_SWEEP_FACTOR,
+                 rendering ? "true" : "false");
+
+    step = 0;
+    setSimPhaseTimes(phaseNs);
+    startStep();
+}
+
+int stressRunHeadless(const StressConfig& cfg, bool render) {
+    beginRun(cfg, render);
+    while (stressFrame(rendering)) {}
+    finishReport();
+    return 0;
+}
+
+void stressBegin(const StressConfig& cfg) {
+    beginRun(cfg, true);
+}
+
+void stressDisplay() {
+    if (!stressFrame(true)) {
+        finishReport();
+        std::exit(0);
+    }
+    glutPostRedisplay();   // next frame straight away, no frame pacing
+}
@@ -0,0 +1,64 @@
+// stress.h
+#ifndef STRESS_H
+#define STRESS_H
+
+// Stress scenarios: macro-benchmark launch mode.
+//
+//     TankGame --stress [--tanks N] [--bullets N] [--targets N] [--ticks N]
+//              [--pattern spray|volley|idle] [--sweep STEPS] [--step K]
+//              [--headless] [--out report.json]
+//
+// The player tank plus (tanks - 1) bots (game.h) run a scripted firing
+// pattern for a fixed number of ticks, back to back on one thread: tick,
+// snapshot, and (unless headless) draw. Each step of a sweep multiplies the
+// tank / bullet / target counts by STRESS_SWEEP_FACTOR. --step K fast-forwards:
+// every frame simulates K ticks in one (setSimStepTicks), so a run of
+// --ticks N draws N / K frames; the scores show whether hits still match.
+//
+// The JSON report has, per step: ticks/sec, frame time percentiles (one
+// frame = tick + snapshot + draw), peak RSS so far and the average time of
+// each sim phase (see SimPhase) plus snapshot and render.
+//
+// tank_bench --stress takes the same options and always draws, into the
+// null GL backend (CPU cost of recording + submission).
+
+constexpr int      STRESS_SWEEP_FACTOR  = 4;
+constexpr int      STRESS_DEFAULT_TICKS = 600;   // 10 s of game time
+constexpr unsigned STRESS_SEED          = 20240u;
+
+enum StressPattern {
+    STRESS_SPRAY,    // every tank drives and turns, firing every few ticks
+    STRESS_VOLLEY,   // tanks hold position and fire at targets together
+    STRESS_IDLE      // tanks drive and turn, no firing (movement + fog only)
+};
+
+struct StressConfig {
+    bool          enabled  = false;   // --stress given
+    int           tanks    = 1;       // including the player
+    int           bullets  = 0;       // 0 = MAX_BULLETS
+    int           targets  = 0;       // 0 = NUM_TARGETS
+    int           ticks    = STRESS_DEFAULT_TICKS;
+    int           steps    = 1;       // sweep steps
+    int           simStep  = 1;       // ticks per updateGame() (--step)
+    StressPattern pattern  = STRESS_SPRAY;
+    bool          headless = false;   // no window: sim + snapshot only
+    const char*   outPath  = nullptr; // nullptr = stdout
+};
+
+// --- Stress runs (Defined in stress.cpp) ---
+
+// Fills 'config' from the command line. Returns false (after printing the
+// usage) on a bad option; without --stress it leaves config.enabled false.
+bool stressParseArgs(int argc, char** argv, StressConfig& config);
+
+// Runs the whole sweep without GLUT and writes the report; returns the
+// process exit code. 'render' draws every frame (needs a GL backend).
+int stressRunHeadless(const StressConfig& config, bool render);
+
+// Windowed runs: stressBegin() after initGraphics(), then stressDisplay() as
+// the GLUT display callback. It runs one frame per call and exits the
+// process with the report written after the last step.
+void stressBegin(const StressConfig& config);
+void stressDisplay();
+
+#endif // STRESS_H
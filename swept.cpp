@@ -0,0 +1,67 @@
+// swept.cpp
+#include <algorithm>
+#include <cstdint>
+
+#include "swept.h"
+
+constexpr Fixed FX_ZERO = Fixed::fromInt(0);
+constexpr Fixed FX_ONE  = Fixed::fromInt(1);
+
+// With f = p - c: |f + t*d|^2 = r^2. Squares are Q32.32 in int64, and the
+// entry is found from the closest approach tc = -(f.d) / (d.d), backing up by
+// sqrt((r^2 - |f + tc*d|^2) / (d.d)), which keeps every product in range.
+bool sweepCircle(Fixed px, Fixed py, Fixed dx, Fixed dy,
+                 Fixed cx, Fixed cy, Fixed r, Fixed& t) {
+    Fixed   fx  = px - cx;
+    Fixed   fy  = py - cy;
+    int64_t rSq = fxLengthSq(r, FX_ZERO);
+
+    if (fxLengthSq(fx, fy) <= rSq) {   // starts inside
+        t = FX_ZERO;
+        return true;
+    }
+
+    int64_t fd = (int64_t)fx.raw * dx.raw + (int64_t)fy.raw * dy.raw;
+    if (fd >= 0) return false;   // not moving towards the centre
+
+    int64_t dd    = fxLengthSq(dx, dy);
+    int64_t ddQ16 = dd >> Fixed::FRAC_BITS;
+    if (ddQ16 == 0) return false;   // moves less than 1/256 px
+
+    // Closest approach past the end: only the end point can be inside
+    int64_t tc = std::min<int64_t>(-fd / ddQ16, INT32_MAX);
+    if (tc > FX_ONE.raw && fxLengthSq(fx + dx, fy + dy) > rSq) return false;
+
+    Fixed   tcF = Fixed::fromRaw((int32_t)tc);
+    int64_t h   = rSq - fxLengthSq(fx + dx * tcF, fy + dy * tcF);
+    if (h < 0) return false;   // passes outside
+
+    // Back from the closest approach to the circle's edge
+    uint64_t dtSq = ((uint64_t)h << Fixed::FRAC_BITS) / (uint64_t)dd;   // Q16.16
+    int64_t  dt   = (int64_t)isqrt64(dtSq << Fixed::FRAC_BITS);
+
+    t = Fixed::fromRaw((int32_t)std::clamp<int64_t>(tc - dt, 0, FX_ONE.raw));
+    return true;
+}
+
+// Narrows tExit to where p + t*d crosses out of [lo, hi] on one axis
+static bool crossesOut(Fixed p, Fixed d, Fixed lo, Fixed hi, Fixed& tExit) {
+    if (d > FX_ZERO && p + d > hi) {
+        tExit = std::min(tExit, (hi - p) / d);
+        return true;
+    }
+    if (d < FX_ZERO && p + d < lo) {
+        tExit = std::min(tExit, (lo - p) / d);
+        return true;
+    }
+    return false;
+}
+
+bool sweepExitBox(Fixed px, Fixed py, Fixed dx, Fixed dy, const AABB& box, Fixed& t) {
+    Fixed tExit  = FX_ONE;
+    bool  leaves = crossesOut(px, dx, box.minX, box.maxX, tExit);
+    leaves       = crossesOut(py, dy, box.minY, box.maxY, tExit) || leaves;
+
+    t = std::max(tExit, FX_ZERO);
+    return leaves;
+}
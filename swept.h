@@ -0,0 +1,30 @@
+// swept.h
+#ifndef SWEPT_H
+#define SWEPT_H
+
+#include "fixed.h"       // Fixed
+#include "obstacles.h"   // AABB
+
+// Continuous collision for fast-moving points (projectiles).
+//
+// The tests take the whole move of a tick, p -> p + d, and return the
+// fraction t in [0, 1] at which it first touches the shape. A bullet can no
+// longer step over a target between two samples, so a tick may cover any
+// distance: faster shells, or several base ticks per updateGame() in
+// fast-forward runs (setSimStepTicks in game.h), give the same hits.
+//
+// Integer math on Fixed (sqrt included), bit-exact like the rest of the sim.
+// Segment-vs-obstacle queries live in obstacles.h (raycastObstacles).
+
+// --- Tests (Defined in swept.cpp) ---
+
+// First t at which the point p + t*d is within r of (cx, cy); t = 0 when it
+// starts inside
+bool sweepCircle(Fixed px, Fixed py, Fixed dx, Fixed dy,
+                 Fixed cx, Fixed cy, Fixed r, Fixed& t);
+
+// First t at which the point p + t*d, starting inside 'box', leaves it.
+// False if the whole move stays inside (edges count as inside).
+bool sweepExitBox(Fixed px, Fixed py, Fixed dx, Fixed dy, const AABB& box, Fixed& t);
+
+#endif // SWEPT_H
@@ -0,0 +1,220 @@
+// telemetry.cpp
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "telemetry.h"
+#include "game.h"     // TICKS_PER_SECOND
+#include "events.h"   // shots / hits / waves come from the event bus
+
+// =====================================================
+// Mapping
+// =====================================================
+
+static unsigned char*       mapping      = nullptr;
+static size_t               mappingBytes = 0;
+static TelemetryFileHeader* header       = nullptr;
+static TelemetryBlock*      blocks       = nullptr;   // nullptr: telemetry off
+
+#ifdef _WIN32
+static HANDLE fileHandle = INVALID_HANDLE_VALUE;
+static HANDLE mapHandle  = nullptr;
+#else
+static int fileFd = -1;
+#endif
+
+static bool mapFile(const char* path, size_t bytes) {
+#ifdef _WIN32
+    fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    // Mapping a size larger than the file extends it
+    mapHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+                                   (DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, nullptr);
+    if (mapHandle) mapping = static_cast<unsigned char*>(MapViewOfFile(mapHandle, FILE_MAP_WRITE, 0, 0, bytes));
+    if (!mapping) {
+        if (mapHandle) CloseHandle(mapHandle);
+        CloseHandle(fileHandle);
+        mapHandle  = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+#else
+    fileFd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileFd < 0) return false;
+
+    void* p = MAP_FAILED;
+    if (ftruncate(fileFd, (off_t)bytes) == 0) {
+        p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileFd, 0);
+    }
+    if (p == MAP_FAILED) {
+        close(fileFd);
+        fileFd = -1;
+        return false;
+    }
+    mapping = static_cast<unsigned char*>(p);
+#endif
+    mappingBytes = bytes;
+    return true;
+}
+
+static void unmapFile() {
+#ifdef _WIN32
+    FlushViewOfFile(mapping, mappingBytes);
+    UnmapViewOfFile(mapping);
+    CloseHandle(mapHandle);
+    CloseHandle(fileHandle);
+    mapHandle  = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    msync(mapping, mappingBytes, MS_SYNC);
+    munmap(mapping, mappingBytes);
+    close(fileFd);
+    fileFd = -1;
+#endif
+    mapping      = nullptr;
+    mappingBytes = 0;
+}
+
+// =====================================================
+// Writer state (sim thread)
+// =====================================================
+
+static TelemetryBlock* current = nullptr;   // block being filled
+static uint32_t        match   = 0;
+static uint16_t        wave    = 0;   // latest wave spawned this match
+static int32_t         lastX = 0, lastY = 0, lastAngle = 0;
+static EventCursor     events  = {0, 0};
+
+// Written by the GLUT thread, sampled by the sim thread
+static std::atomic<unsigned> frameMicros{0};
+
+bool telemetryOpen(const char* path, int blockCount) {
+    if (blocks) telemetryClose();
+    blockCount = std::max(1, blockCount);
+
+    size_t bytes = sizeof(TelemetryFileHeader) + sizeof(TelemetryBlock) * (size_t)blockCount;
+    if (!mapFile(path, bytes)) return false;
+
+    // Touch every page now, so the first lap of the ring does not page-fault
+    // inside a tick
+    std::memset(mapping, 0, bytes);
+
+    header = reinterpret_cast<TelemetryFileHeader*>(mapping);
+    blocks = reinterpret_cast<TelemetryBlock*>(mapping + sizeof(TelemetryFileHeader));
+
+    std::memcpy(header->magic, TELEMETRY_MAGIC, sizeof(header->magic));
+    header->version        = TELEMETRY_VERSION;
+    header->blockSize      = sizeof(TelemetryBlock);
+    header->blockCount     = (uint32_t)blockCount;
+    header->ticksPerSecond = TICKS_PER_SECOND;
+    header->blocksStarted  = 0;
+
+    current = nullptr;
+    match   = 0;
+    wave    = 0;
+    events  = gameEvents.subscribe();
+    return true;
+}
+
+void telemetryClose() {
+    if (!blocks) return;
+    unmapFile();
+    header  = nullptr;
+    blocks  = nullptr;
+    current = nullptr;
+}
+
+void telemetryReportFrameTime(unsigned micros) {
+    frameMicros.store(micros, std::memory_order_relaxed);
+}
+
+// Opens the next ring slot with a key frame at the given state
+static void startBlock(unsigned long long tick, int32_t x, int32_t y, int32_t angle,
+                       int score, bool newMatch) {
+    if (newMatch || match == 0) ++match;
+
+    uint64_t seq = ++header->blocksStarted;
+    TelemetryBlock* b = &blocks[(seq - 1) % header->blockCount];
+
+    // A reader ignores the slot while seq is 0, so the key frame is never
+    // seen half written next to the previous lap's columns
+    b->seq       = 0;
+    b->firstTick = tick;
+    b->match     = match;
+    b->score     = score;
+    b->x         = x;
+    b->y         = y;
+    b->angle     = angle;
+    b->count     = 0;
+    b->wave      = wave;
+    b->seq       = seq;
+    current = b;
+}
+
+static bool fitsInt8(int32_t v) {
+    return v >= -128 && v <= 127;
+}
+
+void telemetryRecordTick(unsigned long long tick, float x, float y, float angle,
+                         int score, unsigned tickMicros) {
+    if (!blocks) return;
+
+    // Everything updateGame() reported since the previous sample
+    unsigned shots = 0, hits = 0;
+    uint8_t  flags = 0;
+    bool     newMatch = false;
+    GameEvent e;
+    while (gameEvents.poll(events, e)) {
+        switch (e.type) {
+        case EVENT_BULLET_FIRED: ++shots; break;
+        case EVENT_TARGET_HIT:   ++hits;  break;
+        case EVENT_SHELL_IMPACT: break;
+        case EVENT_WAVE_SPAWNED:
+            flags |= TELEMETRY_WAVE_SPAWNED;
+            if (e.waveSpawned.wave == 1) newMatch = true;
+            wave = (uint16_t)e.waveSpawned.wave;
+            break;
+        case EVENT_GAME_OVER:
+            flags |= TELEMETRY_GAME_OVER;
+            break;
+        }
+    }
+
+    int32_t qx = (int32_t)std::lround(x * TELEMETRY_POS_SCALE);
+    int32_t qy = (int32_t)std::lround(y * TELEMETRY_POS_SCALE);
+    int32_t qa = (int32_t)std::lround(angle * TELEMETRY_ANGLE_SCALE);
+    int32_t dx = qx - lastX, dy = qy - lastY, da = qa - lastAngle;
+
+    if (!current || current->count == TELEMETRY_TICKS_PER_BLOCK || newMatch ||
+        !fitsInt8(dx) || !fitsInt8(dy) || !fitsInt8(da)) {
+        startBlock(tick, qx, qy, qa, score, newMatch);
+        dx = dy = da = 0;
+    }
+
+    int i = current->count;
+    current->dx[i]      = (int8_t)dx;
+    current->dy[i]      = (int8_t)dy;
+    current->dAngle[i]  = (int8_t)da;
+    current->shots[i]   = (uint8_t)std::min(shots, 255u);
+    current->hits[i]    = (uint8_t)std::min(hits, 255u);
+    current->flags[i]   = flags;
+    current->tickUs[i]  = (uint16_t)std::min(tickMicros, 65535u);
+    current->frameUs[i] = (uint16_t)std::min(frameMicros.load(std::memory_order_relaxed), 65535u);
+    current->count = (uint16_t)(i + 1);   // publishes the tick to a crash-time reader
+
+    lastX = qx;
+    lastY = qy;
+    lastAngle = qa;
+}
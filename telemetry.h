@@ -0,0 +1,86 @@
+// telemetry.h
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstdint>
+
+// Gameplay telemetry log.
+//
+// The sim thread records one sample per tick (tank pose, shots, hits, waves,
+// tick and frame times) into a memory-mapped ring file. The file is sized
+// once when it is opened; recording only stores into the mapping, so the
+// tick path does no allocation and no system calls, and the OS writes the
+// pages back on its own.
+//
+// The file is a header followed by fixed-size blocks, each covering up to
+// TELEMETRY_TICKS_PER_BLOCK ticks. Inside a block the data is columnar: a key
+// frame with absolute values, then one array per field holding per-tick
+// deltas / counts. When the ring is full the oldest block is overwritten.
+//
+// Shots, hits and waves come from the game event bus (events.h).
+// tools/telemetry2csv converts a log to CSV.
+
+// ---- File format (shared with tools/telemetry2csv.cpp) ----
+
+constexpr char     TELEMETRY_MAGIC[8]        = {'T', 'N', 'K', 'T', 'L', 'M', '0', '1'};
+constexpr uint32_t TELEMETRY_VERSION         = 1;
+constexpr int      TELEMETRY_TICKS_PER_BLOCK = 64;
+constexpr int      TELEMETRY_DEFAULT_BLOCKS  = 4096;   // ~68 minutes at 60 ticks/s, ~2.8 MB
+constexpr int      TELEMETRY_POS_SCALE       = 16;     // positions in 1/16 px
+constexpr int      TELEMETRY_ANGLE_SCALE     = 4;      // angles in 1/4 degree
+
+// flags[] bits
+constexpr uint8_t TELEMETRY_WAVE_SPAWNED = 1;
+constexpr uint8_t TELEMETRY_GAME_OVER    = 2;
+
+struct TelemetryFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t blockSize;        // sizeof(TelemetryBlock)
+    uint32_t blockCount;       // ring capacity
+    uint32_t ticksPerSecond;
+    uint64_t blocksStarted;    // blocks begun since the file was created
+    uint8_t  reserved[32];
+};
+static_assert(sizeof(TelemetryFileHeader) == 64, "header is one cache line");
+
+struct TelemetryBlock {
+    // Key frame: absolute values at the first tick
+    uint64_t seq;              // 1-based block number, 0 = slot never written
+    uint64_t firstTick;
+    uint32_t match;            // 1-based round number (restart = new match)
+    int32_t  score;            // score after the first tick
+    int32_t  x, y;             // tank position, 1/16 px
+    int32_t  angle;            // tank heading, 1/4 degree
+    uint16_t count;            // ticks recorded, updated after each tick's columns
+    uint16_t wave;             // waves spawned this match, up to the first tick
+
+    // Columns, one entry per tick. Deltas are to the previous tick (0 for the
+    // first); a move that does not fit starts a new block with a fresh key frame.
+    int8_t   dx[TELEMETRY_TICKS_PER_BLOCK];
+    int8_t   dy[TELEMETRY_TICKS_PER_BLOCK];
+    int8_t   dAngle[TELEMETRY_TICKS_PER_BLOCK];
+    uint8_t  shots[TELEMETRY_TICKS_PER_BLOCK];     // bullets fired
+    uint8_t  hits[TELEMETRY_TICKS_PER_BLOCK];      // targets destroyed
+    uint8_t  flags[TELEMETRY_TICKS_PER_BLOCK];     // TELEMETRY_* bits
+    uint16_t tickUs[TELEMETRY_TICKS_PER_BLOCK];    // sim tick duration, microseconds
+    uint16_t frameUs[TELEMETRY_TICKS_PER_BLOCK];   // latest render frame interval, microseconds
+};
+
+// --- Writer (Defined in telemetry.cpp) ---
+
+// Creates / truncates 'path' and maps it; returns false if that failed
+// (telemetry then stays off). Call before initGame() to capture the first wave.
+bool telemetryOpen(const char* path, int blockCount = TELEMETRY_DEFAULT_BLOCKS);
+
+// Flushes and unmaps the file
+void telemetryClose();
+
+// Sim thread, once per tick after updateGame(); no-op when telemetry is off
+void telemetryRecordTick(unsigned long long tick, float x, float y, float angle,
+                         int score, unsigned tickMicros);
+
+// GLUT thread: interval between the last two rendered frames
+void telemetryReportFrameTime(unsigned frameMicros);
+
+#endif // TELEMETRY_H
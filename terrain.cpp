@@ -0,0 +1,258 @@
+// terrain.cpp
+#include <GL/glut.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include "glstate.h"
+#include "terrain.h"
+#include "profiler.h"   // must stay last: hooks GL calls when profiling
+
+// ---- Track area (must match graphics.cpp) ----
+constexpr int TRACK_X_MIN = 120;
+constexpr int TRACK_Y_MIN = 120;
+constexpr int TRACK_X_MAX = TRACK_X_MIN + 560;
+constexpr int TRACK_Y_MAX = TRACK_Y_MIN + 360;
+
+// Crater / scorch footprint: cells within 'radius' of the centre
+static bool withinRadius(int dx, int dy, int radius) {
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+// =====================================================
+// Materials (sim thread)
+// =====================================================
+
+static uint8_t material[TERRAIN_ROWS][TERRAIN_COLS];   // TerrainMaterial per cell
+
+// Speed multiplier per TerrainMaterial
+static constexpr Fixed MATERIAL_SPEED[] = {
+    Fixed::fromFloat(0.8f),   // grass
+    Fixed::fromInt(1),        // asphalt
+    Fixed::fromFloat(0.5f),   // crater: churned-up rubble
+};
+
+void terrainReset() {
+    for (int row = 0; row < TERRAIN_ROWS; ++row) {
+        int y = row * TERRAIN_CELL + TERRAIN_CELL / 2;
+        for (int col = 0; col < TERRAIN_COLS; ++col) {
+            int  x = col * TERRAIN_CELL + TERRAIN_CELL / 2;
+            bool onTrack = x >= TRACK_X_MIN && x < TRACK_X_MAX && y >= TRACK_Y_MIN && y < TRACK_Y_MAX;
+            material[row][col] = onTrack ? TERRAIN_ASPHALT : TERRAIN_GRASS;
+        }
+    }
+}
+
+void terrainCellOf(Fixed x, Fixed y, int& col, int& row) {
+    col = std::clamp(x.floorInt() / TERRAIN_CELL, 0, TERRAIN_COLS - 1);
+    row = std::clamp(y.floorInt() / TERRAIN_CELL, 0, TERRAIN_ROWS - 1);
+}
+
+void terrainImpact(int col, int row) {
+    const int r = TERRAIN_CRATER_RADIUS;
+    for (int y = std::max(row - r, 0); y <= std::min(row + r, TERRAIN_ROWS - 1); ++y) {
+        for (int x = std::max(col - r, 0); x <= std::min(col + r, TERRAIN_COLS - 1); ++x) {
+            if (withinRadius(x - col, y - row, r)) material[y][x] = TERRAIN_CRATER;
+        }
+    }
+}
+
+TerrainMaterial terrainMaterialAt(Fixed x, Fixed y) {
+    int col, row;
+    terrainCellOf(x, y, col, row);
+    return (TerrainMaterial)material[row][col];
+}
+
+Fixed terrainSpeedFactor(Fixed x, Fixed y) {
+    return MATERIAL_SPEED[terrainMaterialAt(x, y)];
+}
+
+// =====================================================
+// Decals (GLUT thread)
+// =====================================================
+
+// Power-of-two texture (GL 1.x), the grid uses its lower-left
+// TERRAIN_COLS x TERRAIN_ROWS texels
+constexpr int TERRAIN_TEX_W     = 512;
+constexpr int TERRAIN_TEX_H     = 512;
+constexpr int MAX_DIRTY_RECTS   = 16;
+constexpr int CRATER_ALPHA      = 235;
+constexpr int SCORCH_ALPHA      = 160;   // at the crater's edge, fading out to SCORCH_RADIUS
+
+// Cells [col0, col1) x [row0, row1)
+struct CellRect {
+    int col0, row0;
+    int col1, row1;
+};
+
+static GLuint       terrainTexture = 0;
+static GLubyte      decals[TERRAIN_ROWS][TERRAIN_COLS][4];   // RGBA, also the upload source
+static bool         anyDecals  = false;
+static CellRect     dirty[MAX_DIRTY_RECTS];
+static int          dirtyCount = 0;
+static int          stamped    = 0;                           // impacts since the last draw
+static TerrainStats stats;
+
+static CellRect unite(const CellRect& a, const CellRect& b) {
+    return {std::min(a.col0, b.col0), std::min(a.row0, b.row0),
+            std::max(a.col1, b.col1), std::max(a.row1, b.row1)};
+}
+
+static long long area(const CellRect& r) {
+    return (long long)(r.col1 - r.col0) * (r.row1 - r.row0);
+}
+
+// Overlapping or sharing an edge
+static bool touches(const CellRect& a, const CellRect& b) {
+    return a.col0 <= b.col1 && b.col0 <= a.col1 && a.row0 <= b.row1 && b.row0 <= a.row1;
+}
+
+// Adds r to the frame's dirty list. Rects that touch are merged, so a
+// cluster of impacts becomes one upload. When the list is full, r joins the
+// rect that grows the least.
+static void addDirtyRect(CellRect r) {
+    for (int i = 0; i < dirtyCount; ) {
+        if (touches(dirty[i], r)) {
+            r = unite(r, dirty[i]);
+            dirty[i] = dirty[--dirtyCount];
+            i = 0;   // the union may touch rects already passed
+        } else {
+            ++i;
+        }
+    }
+
+    if (dirtyCount < MAX_DIRTY_RECTS) {
+        dirty[dirtyCount++] = r;
+        return;
+    }
+
+    int       best = 0;
+    long long bestGrowth = LLONG_MAX;
+    for (int i = 0; i < dirtyCount; ++i) {
+        long long growth = area(unite(dirty[i], r)) - area(dirty[i]);
+        if (growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+    dirty[best] = unite(dirty[best], r);
+}
+
+// Cheap per-cell hash, so crater floors are not flat colour
+static int cellNoise(int col, int row) {
+    unsigned h = (unsigned)col * 73856093u ^ (unsigned)row * 19349663u;
+    return (int)((h >> 13) & 31u) - 16;
+}
+
+static void setTexel(GLubyte* texel, int r, int g, int b, int a) {
+    texel[0] = (GLubyte)std::clamp(r, 0, 255);
+    texel[1] = (GLubyte)std::clamp(g, 0, 255);
+    texel[2] = (GLubyte)std::clamp(b, 0, 255);
+    texel[3] = (GLubyte)a;
+}
+
+void terrainStampImpact(int col, int row) {
+    const int crater = TERRAIN_CRATER_RADIUS;
+    const int scorch = TERRAIN_SCORCH_RADIUS;
+
+    CellRect r = {std::max(col - scorch, 0), std::max(row - scorch, 0),
+                  std::min(col + scorch + 1, TERRAIN_COLS), std::min(row + scorch + 1, TERRAIN_ROWS)};
+
+    for (int y = r.row0; y < r.row1; ++y) {
+        for (int x = r.col0; x < r.col1; ++x) {
+            int dx = x - col, dy = y - row;
+            GLubyte* texel = decals[y][x];
+
+            if (withinRadius(dx, dy, crater)) {
+                // Churned soil, lighter on the rim
+                int shade = cellNoise(x, y) + (withinRadius(dx, dy, crater - 1) ? 0 : 28);
+                setTexel(texel, 92 + shade, 68 + shade, 42 + shade / 2, CRATER_ALPHA);
+            } else if (withinRadius(dx, dy, scorch)) {
+                // Soot, fading with distance; never lightens a darker mark
+                int d2 = dx * dx + dy * dy;
+                int a  = SCORCH_ALPHA * (scorch * scorch - d2) / (scorch * scorch - crater * crater);
+                if (a > texel[3]) setTexel(texel, 18, 14, 10, a);
+            }
+        }
+    }
+
+    addDirtyRect(r);
+    anyDecals = true;
+    ++stamped;
+}
+
+void terrainClearDecals() {
+    std::memset(decals, 0, sizeof(decals));
+    if (anyDecals) {
+        dirty[0]   = {0, 0, TERRAIN_COLS, TERRAIN_ROWS};
+        dirtyCount = 1;
+    }
+    anyDecals = false;
+}
+
+static void createTerrainTexture() {
+    std::vector<GLubyte> clear(TERRAIN_TEX_W * TERRAIN_TEX_H * 4, 0);
+
+    glGenTextures(1, &terrainTexture);
+    gsBindTexture2D(terrainTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    gsPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TERRAIN_TEX_W, TERRAIN_TEX_H, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, clear.data());
+}
+
+void drawTerrain() {
+    PROFILE_SCOPE("drawTerrain");
+
+    if (!terrainTexture) createTerrainTexture();
+    else                 gsBindTexture2D(terrainTexture);
+
+    // Dirty rectangles only, read in place: the bitmap's row length is the
+    // grid width, so no staging copy is needed
+    stats.impacts        = stamped;
+    stats.rectsUploaded  = dirtyCount;
+    stats.texelsUploaded = 0;
+    if (dirtyCount) {
+        gsPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        gsPixelStorei(GL_UNPACK_ROW_LENGTH, TERRAIN_COLS);
+        for (int i = 0; i < dirtyCount; ++i) {
+            const CellRect& r = dirty[i];
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r.col0, r.row0, r.col1 - r.col0, r.row1 - r.row0,
+                            GL_RGBA, GL_UNSIGNED_BYTE, decals[r.row0][r.col0]);
+            stats.texelsUploaded += (int)area(r);
+        }
+        gsPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    dirtyCount = 0;
+    stamped    = 0;
+
+    if (!anyDecals) return;
+
+    // One quad over the window; texel colour as is, alpha blended
+    const float s = (float)TERRAIN_COLS / TERRAIN_TEX_W;
+    const float t = (float)TERRAIN_ROWS / TERRAIN_TEX_H;
+    const float x1 = TERRAIN_COLS * TERRAIN_CELL;
+    const float y1 = TERRAIN_ROWS * TERRAIN_CELL;
+    static const GLfloat WHITE[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    gsMatrixMode(GL_MODELVIEW);
+    gsLoadIdentity();
+    gsEnable(GL_TEXTURE_2D);
+    gsEnable(GL_BLEND);
+    gsColor4fv(WHITE);   // GL_MODULATE: keep the texel colour
+    glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(0.0f, 0.0f);
+        glTexCoord2f(s,    0.0f); glVertex2f(x1,   0.0f);
+        glTexCoord2f(s,    t);    glVertex2f(x1,   y1);
+        glTexCoord2f(0.0f, t);    glVertex2f(0.0f, y1);
+    glEnd();
+    gsDisable(GL_TEXTURE_2D);
+}
+
+const TerrainStats& terrainStats() {
+    return stats;
+}
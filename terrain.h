@@ -0,0 +1,77 @@
+// terrain.h
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <cstdint>
+
+#include "fixed.h"   // Fixed (sim coordinates)
+
+// Destructible ground: shell impacts leave craters and scorch marks.
+//
+// The ground is a grid of TERRAIN_CELL px cells over the whole window, kept
+// in two halves:
+//  - Sim side (sim thread): one material per cell. terrainImpact() digs a
+//    crater, and terrainSpeedFactor() slows tanks crossing rough ground.
+//    Integer only, so it stays as deterministic as the rest of the sim.
+//  - Render side (GLUT thread): an RGBA decal bitmap drawn over the ground
+//    (background + track) and under scenery and walls. terrainStampImpact()
+//    paints an impact into it and adds the touched cells to a short list of
+//    dirty rectangles. drawTerrain() uploads only those rectangles, with
+//    glTexSubImage2D straight out of the bitmap, then draws one quad.
+//
+// The GLUT thread learns about impacts from EVENT_SHELL_IMPACT (events.h).
+// The event carries the crater's cell, so both halves stamp the same cells.
+// A consumer that falls behind the event ring loses decals, never material.
+
+// ---- Grid (whole window, must match game.h / graphics.cpp) ----
+
+constexpr int TERRAIN_CELL = 2;     // pixels per cell
+constexpr int TERRAIN_COLS = 400;   // 800 px
+constexpr int TERRAIN_ROWS = 300;   // 600 px
+
+constexpr int TERRAIN_CRATER_RADIUS = 3;   // cells; rough ground (material + decal)
+constexpr int TERRAIN_SCORCH_RADIUS = 7;   // cells; scorch marks (decal only)
+
+enum TerrainMaterial : uint8_t {
+    TERRAIN_GRASS,
+    TERRAIN_ASPHALT,
+    TERRAIN_CRATER
+};
+
+struct TerrainStats {
+    int impacts;          // decals stamped during the last frame
+    int rectsUploaded;    // glTexSubImage2D calls in the last drawTerrain()
+    int texelsUploaded;   // texels they sent (4 bytes each)
+};
+
+// --- Sim side (Defined in terrain.cpp, sim thread) ---
+
+// Restores the undamaged ground (new round)
+void terrainReset();
+
+// Cell under a world point, clamped to the grid
+void terrainCellOf(Fixed x, Fixed y, int& col, int& row);
+
+// Digs a crater centred on cell (col, row)
+void terrainImpact(int col, int row);
+
+TerrainMaterial terrainMaterialAt(Fixed x, Fixed y);
+
+// Speed multiplier for a tank centred on (x, y)
+Fixed terrainSpeedFactor(Fixed x, Fixed y);
+
+// --- Render side (GLUT thread) ---
+
+// Paints the crater + scorch decal of an impact at cell (col, row)
+void terrainStampImpact(int col, int row);
+
+// Removes every decal (new round)
+void terrainClearDecals();
+
+// Uploads the dirty rectangles, then draws the decals in window
+// coordinates. Call between the ground layer and the static layer.
+void drawTerrain();
+
+const TerrainStats& terrainStats();
+
+#endif // TERRAIN_H
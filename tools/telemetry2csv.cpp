@@ -0,0 +1,167 @@
+// telemetry2csv.cpp
+//
+// Converts a gameplay telemetry log (see telemetry.h) to CSV.
+//
+// Usage: telemetry2csv <log> [--waves]
+//   default   one row per tick:
+//             match,tick,x,y,angle,shots,hits,score,wave_spawned,game_over,tick_us,frame_us
+//   --waves   one row per completed wave (balancing summary):
+//             match,wave,start_tick,end_tick,time_to_kill_s,shots,hits,accuracy
+//
+// Blocks are decoded in sequence order, so a ring that wrapped is printed
+// oldest first. The CSV goes to stdout.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../telemetry.h"
+
+struct TickRow {
+    uint32_t           match;
+    unsigned long long tick;
+    float              x, y, angle;
+    int                shots, hits, score;
+    int                wave;          // waves spawned this match so far
+    bool               waveSpawned, gameOver;
+    int                tickUs, frameUs;
+};
+
+static bool readLog(const char* path, TelemetryFileHeader& header, std::vector<TelemetryBlock>& blocks) {
+    std::FILE* in = std::fopen(path, "rb");
+    if (!in) {
+        std::fprintf(stderr, "telemetry2csv: cannot open %s\n", path);
+        return false;
+    }
+
+    bool ok = std::fread(&header, sizeof(header), 1, in) == 1 &&
+              std::memcmp(header.magic, TELEMETRY_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == TELEMETRY_VERSION &&
+              header.blockSize == sizeof(TelemetryBlock);
+    if (!ok) {
+        std::fprintf(stderr, "telemetry2csv: %s is not a version %u telemetry log\n", path, TELEMETRY_VERSION);
+        std::fclose(in);
+        return false;
+    }
+
+    blocks.resize(header.blockCount);
+    size_t got = std::fread(blocks.data(), sizeof(TelemetryBlock), blocks.size(), in);
+    std::fclose(in);
+    blocks.resize(got);   // a truncated file still yields its complete blocks
+
+    // Unwritten slots have seq 0; the rest are replayed oldest first
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                [](const TelemetryBlock& b) { return b.seq == 0 || b.count == 0; }),
+                 blocks.end());
+    std::sort(blocks.begin(), blocks.end(),
+              [](const TelemetryBlock& a, const TelemetryBlock& b) { return a.seq < b.seq; });
+    return true;
+}
+
+// Undoes the delta encoding of one block
+static void decodeBlock(const TelemetryBlock& b, std::vector<TickRow>& rows) {
+    int32_t x = b.x, y = b.y, angle = b.angle;
+    int score = b.score;
+    int wave  = b.wave;
+    int count = std::min<int>(b.count, TELEMETRY_TICKS_PER_BLOCK);
+
+    for (int i = 0; i < count; ++i) {
+        x += b.dx[i];
+        y += b.dy[i];
+        angle += b.dAngle[i];
+        // The key frame's score / wave already include tick 0
+        if (i > 0) {
+            score += b.hits[i];
+            if (b.flags[i] & TELEMETRY_WAVE_SPAWNED) ++wave;
+        }
+
+        TickRow r;
+        r.match       = b.match;
+        r.tick        = b.firstTick + i;
+        r.x           = (float)x / TELEMETRY_POS_SCALE;
+        r.y           = (float)y / TELEMETRY_POS_SCALE;
+        r.angle       = (float)angle / TELEMETRY_ANGLE_SCALE;
+        r.shots       = b.shots[i];
+        r.hits        = b.hits[i];
+        r.score       = score;
+        r.wave        = wave;
+        r.waveSpawned = (b.flags[i] & TELEMETRY_WAVE_SPAWNED) != 0;
+        r.gameOver    = (b.flags[i] & TELEMETRY_GAME_OVER) != 0;
+        r.tickUs      = b.tickUs[i];
+        r.frameUs     = b.frameUs[i];
+        rows.push_back(r);
+    }
+}
+
+static void printTicks(const std::vector<TickRow>& rows) {
+    std::printf("match,tick,x,y,angle,shots,hits,score,wave_spawned,game_over,tick_us,frame_us\n");
+    for (const TickRow& r : rows) {
+        std::printf("%u,%llu,%.4f,%.4f,%.2f,%d,%d,%d,%d,%d,%d,%d\n",
+                    r.match, r.tick, r.x, r.y, r.angle, r.shots, r.hits, r.score,
+                    r.waveSpawned ? 1 : 0, r.gameOver ? 1 : 0, r.tickUs, r.frameUs);
+    }
+}
+
+// A wave runs from its spawn to the next spawn in the same match; waves cut
+// short by a restart, the end of the round or the end of the log are skipped
+static void printWaves(const std::vector<TickRow>& rows, uint32_t ticksPerSecond) {
+    std::printf("match,wave,start_tick,end_tick,time_to_kill_s,shots,hits,accuracy\n");
+
+    uint32_t match = 0;
+    int wave = 0, shots = 0, hits = 0;   // 'wave' is the running wave's number
+    bool open = false;
+    unsigned long long start = 0;
+
+    for (const TickRow& r : rows) {
+        if (r.match != match) {   // new round: the running wave never finished
+            match = r.match;
+            open  = false;
+        }
+        if (r.waveSpawned) {
+            // The hit that cleared the previous wave lands in the tick that spawns the next
+            shots += r.shots;
+            hits  += r.hits;
+            if (open) {
+                std::printf("%u,%d,%llu,%llu,%.3f,%d,%d,%.3f\n", match, wave, start, r.tick,
+                            (double)(r.tick - start) / ticksPerSecond, shots, hits,
+                            shots ? (double)hits / shots : 0.0);
+            }
+            wave  = r.wave;
+            open  = true;
+            start = r.tick;
+            shots = hits = 0;
+            continue;
+        }
+        if (r.gameOver) open = false;
+        shots += r.shots;
+        hits  += r.hits;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool waves = false;
+    bool usage = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--waves")) waves = true;
+        else if (!path)                        path = argv[i];
+        else                                   usage = true;
+    }
+    if (!path || usage) {
+        std::fprintf(stderr, "usage: %s <telemetry.tlm> [--waves]\n", argv[0]);
+        return 1;
+    }
+
+    TelemetryFileHeader header;
+    std::vector<TelemetryBlock> blocks;
+    if (!readLog(path, header, blocks)) return 1;
+
+    std::vector<TickRow> rows;
+    rows.reserve(blocks.size() * TELEMETRY_TICKS_PER_BLOCK);
+    for (const TelemetryBlock& b : blocks) decodeBlock(b, rows);
+
+    if (waves) printWaves(rows, header.ticksPerSecond ? header.ticksPerSecond : 60);
+    else       printTicks(rows);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// transform.cpp
+#include "transform.h"
+
+// =====================================================
+// Building
+// =====================================================
+
+void tfClear(TransformGraph& graph) {
+    graph.nodes.clear();
+    graph.pass = 0;
+}
+
+int tfAdd(TransformGraph& graph, int parent, Fixed x, Fixed y, BAngle angle, Fixed scale) {
+    TransformNode node = {};
+    node.parent = parent;
+    node.x      = x;
+    node.y      = y;
+    node.angle  = angle;
+    node.scale  = scale;
+    node.dirty  = true;
+    graph.nodes.push_back(node);
+    return (int)graph.nodes.size() - 1;
+}
+
+// =====================================================
+// Per tick
+// =====================================================
+
+void tfSetLocal(TransformGraph& graph, int node, Fixed x, Fixed y, BAngle angle) {
+    TransformNode& n = graph.nodes[node];
+    if (n.x == x && n.y == y && n.angle == angle) return;
+
+    n.x     = x;
+    n.y     = y;
+    n.angle = angle;
+    n.dirty = true;
+}
+
+// Local matrix T(x, y) * R(angle) * S(scale), then parent * local
+static void recompute(TransformNode& n, const TransformNode* parent) {
+    Fixed cs = fxCos(n.angle) * n.scale;
+    Fixed sn = fxSin(n.angle) * n.scale;
+
+    if (!parent) {
+        n.world      = {cs, sn, -sn, cs, n.x, n.y};
+        n.worldAngle = n.angle;
+        return;
+    }
+
+    const Affine2& p = parent->world;
+    n.world.a    = p.a * cs + p.c * sn;
+    n.world.b    = p.b * cs + p.d * sn;
+    n.world.c    = p.c * cs - p.a * sn;
+    n.world.d    = p.d * cs - p.b * sn;
+    n.world.tx   = p.a * n.x + p.c * n.y + p.tx;
+    n.world.ty   = p.b * n.x + p.d * n.y + p.ty;
+    n.worldAngle = (BAngle)(parent->worldAngle + n.angle);
+}
+
+int tfUpdate(TransformGraph& graph, int first, int last) {
+    unsigned pass = ++graph.pass;
+    int      count = 0;
+
+    for (int i = first; i < last; ++i) {
+        TransformNode&       n      = graph.nodes[i];
+        const TransformNode* parent = n.parent >= 0 ? &graph.nodes[n.parent] : nullptr;
+
+        // A parent recomputed in this pass moves the whole subtree
+        if (!n.dirty && !(parent && parent->stamp == pass)) continue;
+
+        recompute(n, parent);
+        n.dirty = false;
+        n.stamp = pass;
+        ++count;
+    }
+    return count;
+}
+
+int tfUpdate(TransformGraph& graph) {
+    return tfUpdate(graph, 0, (int)graph.nodes.size());
+}
+
+// =====================================================
+// Matrix helpers
+// =====================================================
+
+void tfApply(const Affine2& m, Fixed x, Fixed y, Fixed& outX, Fixed& outY) {
+    outX = m.a * x + m.c * y + m.tx;
+    outY = m.b * x + m.d * y + m.ty;
+}
+
+void tfToGlMatrix(const Affine2& m, float out[16]) {
+    for (int i = 0; i < 16; ++i) out[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+
+    out[0]  = m.a.toFloat();
+    out[1]  = m.b.toFloat();
+    out[4]  = m.c.toFloat();
+    out[5]  = m.d.toFloat();
+    out[12] = m.tx.toFloat();
+    out[13] = m.ty.toFloat();
+}
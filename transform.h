@@ -0,0 +1,73 @@
+// transform.h
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <vector>
+
+#include "fixed.h"   // Fixed, BAngle (matrices are sim state)
+
+// Transform hierarchy for articulated models (tank hull -> turret -> barrel).
+//
+// Each node has a local offset / rotation / uniform scale relative to its
+// parent and a cached world matrix. Setting a local value that differs from
+// the current one marks the node dirty; tfUpdate() then walks the nodes once,
+// parents before children, and recomputes only dirty nodes and the subtrees
+// below them. A tank that did not move or aim costs one flag test per part.
+//
+// Matrices are Fixed like the rest of the sim, so positions derived from
+// them (the muzzle) are bit-exact. The renderer gets copies through the
+// snapshot and loads them with tfToGlMatrix(); no per-frame trig on its side.
+
+// 2D affine matrix: x' = a x + c y + tx, y' = b x + d y + ty
+struct Affine2 {
+    Fixed a, b;     // image of the local X axis
+    Fixed c, d;     // image of the local Y axis
+    Fixed tx, ty;   // image of the local origin
+};
+
+struct TransformNode {
+    int      parent;       // index of the parent node, -1 = world
+    Fixed    x, y;         // offset in the parent's space
+    BAngle   angle;        // rotation relative to the parent
+    Fixed    scale;        // uniform scale relative to the parent
+    bool     dirty;        // local values changed since the last update
+
+    // Cached by tfUpdate()
+    unsigned stamp;        // update pass that last recomputed 'world'
+    BAngle   worldAngle;   // heading in world space
+    Affine2  world;
+};
+
+// Nodes are appended only, and a parent always comes before its children
+struct TransformGraph {
+    std::vector<TransformNode> nodes;
+    unsigned                   pass = 0;
+};
+
+// --- Building (Defined in transform.cpp) ---
+
+void tfClear(TransformGraph& graph);
+
+// Appends a dirty node and returns its index; parent must already exist
+int tfAdd(TransformGraph& graph, int parent, Fixed x, Fixed y, BAngle angle, Fixed scale);
+
+// --- Per tick ---
+
+// Local transform of a node; marks it dirty only if something changed
+void tfSetLocal(TransformGraph& graph, int node, Fixed x, Fixed y, BAngle angle);
+
+// Recomputes the world matrices of dirty nodes and their descendants in
+// [first, last). Parents outside the range must already be up to date.
+// Returns the number of nodes recomputed.
+int tfUpdate(TransformGraph& graph, int first, int last);
+int tfUpdate(TransformGraph& graph);   // every node
+
+// --- Matrix helpers ---
+
+// 'local' point (x, y) mapped through m
+void tfApply(const Affine2& m, Fixed x, Fixed y, Fixed& outX, Fixed& outY);
+
+// Column-major 4x4 float matrix for rcMultMatrixf()
+void tfToGlMatrix(const Affine2& m, float out[16]);
+
+#endif // TRANSFORM_H